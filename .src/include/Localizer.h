@@ -48,8 +48,41 @@
 #include <filesystem>    ///< std::filesystem
 #include <vector>        ///< std::vector
 #include <algorithm>     ///< std::find
+#include <array>         ///< std::array
+#include <atomic>        ///< std::atomic
+#include <cstdint>       ///< std::uint64_t
+#include <cstring>       ///< std::memcpy
+#include <cstdlib>       ///< std::abort
+#include <cctype>        ///< std::tolower, std::isalnum
+#include <memory>        ///< std::shared_ptr, std::unique_ptr
+#include <string_view>   ///< std::string_view
+#include <memory_resource> ///< std::pmr::memory_resource, std::pmr::monotonic_buffer_resource
+#include <optional>      ///< std::optional
+#include <limits>        ///< std::numeric_limits
+#include <deque>         ///< std::deque
+#include <list>          ///< std::list
+#include <charconv>      ///< std::to_chars
+#include <initializer_list> ///< std::initializer_list
+#include <type_traits>   ///< std::is_same_v
+#include <thread>        ///< std::thread
+#include <chrono>        ///< std::chrono
+#include <mutex>         ///< std::mutex, std::lock_guard, std::call_once
+#include <condition_variable> ///< std::condition_variable
+#include <exception>     ///< std::exception_ptr, std::rethrow_exception
 #include "json.hpp"      ///< nlohmann::json dependency
 
+// Platform headers for pollable change notification
+#if defined(__linux__)
+#include <sys/eventfd.h> ///< eventfd
+#endif
+#if !defined(_WIN32)
+#include <unistd.h>      ///< pipe, read, write, close
+#include <fcntl.h>       ///< fcntl, O_NONBLOCK
+#include <sys/uio.h>     ///< iovec
+#include <sys/mman.h>    ///< mmap, munmap
+#include <sys/stat.h>    ///< fstat
+#endif
+
 // Optional regex support
 #ifndef LOC_USE_REGEX
 #define LOC_USE_REGEX 0
@@ -62,6 +95,22 @@
 #pragma message("LocalizeController: using fast non-regex placeholder parser")
 #endif
 
+// Optional C++20 coroutine support
+#ifndef LOC_USE_COROUTINES
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define LOC_USE_COROUTINES 1
+#else
+#define LOC_USE_COROUTINES 0
+#endif
+#endif
+
+#if LOC_USE_COROUTINES
+#include <coroutine>  ///< std::coroutine_handle
+#include <concepts>   ///< concept support
+#include <exception>  ///< std::exception_ptr
+#include <functional> ///< std::function
+#endif
+
 // Thread-safety configuration
 #ifndef LOC_THREAD_SAFE
 #define LOC_THREAD_SAFE 1
@@ -118,21 +167,21 @@ inline static ErrorCallback DefaultErrorCallback = [](const std::string& msg, in
     std::cerr << "\x1b[31m[ERR] " << msg
               << " [CODE: " << code << "]\x1b[0m\n";
 };
+#endif
 
 /**
- * @brief Macro for raising an error through either user callback or default.
+ * @brief Macro for raising an error.
+ *
+ * @details
+ * Errors are never delivered inline: the event is pushed into the bounded
+ * error queue and handed to the callback (or `std::cerr`) later, either by
+ * the dispatcher thread or by `Localizer::drainErrors()` once the public
+ * entry point has released its lock.
  */
 #define LOC_RAISE_ERROR(msg, code)                                  \
     do {                                                            \
-        if (errorCallback) errorCallback((msg), (code));            \
-        else DefaultErrorCallback((msg), (code));                   \
-    } while (0)
-#else
-#define LOC_RAISE_ERROR(msg, code)                                  \
-    do {                                                            \
-        std::cerr << "[ERR] " << (msg) << " [CODE: " << (code) << "]\n"; \
+        Localizer::enqueueError((msg), (code));                     \
     } while (0)
-#endif
 
 #if LOC_THREAD_SAFE
 #include <mutex>        ///< std::mutex
@@ -161,6 +210,79 @@ inline static ErrorCallback DefaultErrorCallback = [](const std::string& msg, in
 #define LOC_COLOR_RESET "\x1b[0m"
 #endif
 
+#ifndef LOC_ERROR_QUEUE_CAPACITY
+#define LOC_ERROR_QUEUE_CAPACITY 64
+#endif
+
+#ifndef LOC_FRAME_ARENA_CHECKS
+#ifdef NDEBUG
+#define LOC_FRAME_ARENA_CHECKS 0
+#else
+#define LOC_FRAME_ARENA_CHECKS 1
+#endif
+#endif
+
+#if LOC_FRAME_ARENA_CHECKS && defined(__has_include)
+#if __has_include(<sanitizer/asan_interface.h>) && (defined(__SANITIZE_ADDRESS__) || defined(__clang__))
+#include <sanitizer/asan_interface.h> ///< ASAN_POISON_MEMORY_REGION
+#endif
+#endif
+#ifndef ASAN_POISON_MEMORY_REGION
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+
+#ifndef LOC_NEGOTIATION_CACHE_SIZE
+#define LOC_NEGOTIATION_CACHE_SIZE 1024
+#endif
+
+#ifndef LOC_ACCEPT_LANGUAGE_MAX_RANGES
+#define LOC_ACCEPT_LANGUAGE_MAX_RANGES 16
+#endif
+
+#ifndef LOC_CSV_CHUNK_SIZE
+#define LOC_CSV_CHUNK_SIZE 65536
+#endif
+
+#ifndef LOC_BULK_CHUNK_SIZE
+#define LOC_BULK_CHUNK_SIZE 4096
+#endif
+
+#ifndef LOC_DEFERRED_MAX_ARGS
+#define LOC_DEFERRED_MAX_ARGS 8
+#endif
+
+#ifndef LOC_DEFERRED_INLINE_SIZE
+#define LOC_DEFERRED_INLINE_SIZE 64
+#endif
+
+#ifndef LOC_COMPACT_CATALOG
+#define LOC_COMPACT_CATALOG 0
+#endif
+
+#ifndef LOC_TEXT_METRICS
+#if LOC_COMPACT_CATALOG
+#define LOC_TEXT_METRICS 0
+#else
+#define LOC_TEXT_METRICS 1
+#endif
+#endif
+
+#ifndef LOC_SIGNAL_SAFE_SLOTS
+#define LOC_SIGNAL_SAFE_SLOTS 8
+#endif
+
+#ifndef LOC_SIGNAL_SAFE_KEY_SIZE
+#define LOC_SIGNAL_SAFE_KEY_SIZE 64
+#endif
+
+#ifndef LOC_SIGNAL_SAFE_VALUE_SIZE
+#define LOC_SIGNAL_SAFE_VALUE_SIZE 256
+#endif
+
+static_assert((LOC_ERROR_QUEUE_CAPACITY & (LOC_ERROR_QUEUE_CAPACITY - 1)) == 0,
+              "LOC_ERROR_QUEUE_CAPACITY must be a power of two");
+
 // ============================================================================
 // DebugOptions
 // ============================================================================
@@ -200,455 +322,7536 @@ struct DebugOptions
 };
 
 // ============================================================================
-// Localizer
+// LocString
 // ============================================================================
 
 /**
- * @class Localizer
- * @brief Static class for managing all localization operations.
+ * @class LocString
+ * @brief Cheap, immutable handle to a translated value that survives reloads.
  *
  * @details
- * Provides a centralized localization manager capable of:
- * - Loading translation files from directories.
- * - Flattening JSON hierarchies into key-value maps.
- * - Handling runtime reloads and file modification detection.
- * - Performing thread-safe access to localization data.
+ * Points straight into the catalog generation the value was resolved from
+ * and shares ownership of that generation, so copying a handle is one atomic
+ * increment and no text is ever copied. A reload publishes a new generation;
+ * the old one is freed when its last handle is dropped.
+ *
+ * Equality compares identity (same bytes of the same generation). Use
+ * sameText() to compare content.
  */
-class Localizer
+class LocString
 {
+    std::shared_ptr<const char> owner; ///< Shares ownership of the generation; points at the text.
+    std::size_t length = 0;            ///< Text length in bytes.
+    std::uint64_t gen = 0;             ///< Generation the text belongs to (0 if not from a catalog).
+    bool resolved = false;             ///< Whether the key was found.
+
 public:
-    static constexpr const char *DEFAULT_LOCALE = LOC_DEFAULT_LOCALE; ///< Default locale identifier.
+    LocString() = default;
 
-private:
-#if LOC_THREAD_SAFE
     /**
-     * @brief Returns global shared mutex for synchronization.
-     * @return Reference to static shared_mutex.
+     * @brief Creates a handle. Used by Localizer::translateHandle().
+     * @param owner Aliasing pointer to the text sharing ownership of its storage.
+     * @param length Text length in bytes.
+     * @param generation Catalog generation of the text.
+     * @param found Whether the key was found.
      */
-    static std::shared_mutex &getMutex()
+    LocString(std::shared_ptr<const char> owner, std::size_t length, std::uint64_t generation, bool found) noexcept
+        : owner(std::move(owner)), length(length), gen(generation), resolved(found)
     {
-        static std::shared_mutex m;
-        return m;
     }
-#endif
+
+    [[nodiscard]] std::string_view view() const noexcept { return {owner.get(), length}; }
+    [[nodiscard]] const char *data() const noexcept { return owner.get(); }
+    [[nodiscard]] std::size_t size() const noexcept { return length; }
+    [[nodiscard]] bool empty() const noexcept { return length == 0; }
+    [[nodiscard]] bool found() const noexcept { return resolved; }
+    [[nodiscard]] std::uint64_t generation() const noexcept { return gen; }
 
     /**
-     * @struct Node
-     * @brief Internal helper structure for JSON traversal.
+     * @brief Copies the text into a std::string.
      */
-    struct Node
-    {
-        const nlohmann::json *json; ///< Pointer to JSON node.
-        std::string prefix;         ///< Current namespace prefix.
-    };
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+
+    [[nodiscard]] operator std::string_view() const noexcept { return view(); }
 
     /**
-     * @brief Flattens nested JSON into a flat key-value map.
-     * @param root Root JSON object.
-     * @param basePrefix Prefix for current hierarchy.
-     * @param out Output map of flattened keys and values.
+     * @brief Compares content rather than identity.
+     * @param other Handle to compare with.
+     * @return true if both handles hold the same text.
      */
-    static void flattenJsonIterative(const nlohmann::json &root,
-                                     const std::string &basePrefix,
-                                     std::unordered_map<std::string, std::string> &out)
+    [[nodiscard]] bool sameText(const LocString &other) const noexcept { return view() == other.view(); }
+
+    friend bool operator==(const LocString &a, const LocString &b) noexcept
     {
-        std::vector<Node> stack{{&root, basePrefix}};
-        while (!stack.empty())
-        {
-            auto [node, prefix] = stack.back();
-            stack.pop_back();
-            for (auto &[key, value] : node->items())
-            {
-                std::string fullKey = prefix.empty() ? key : prefix + LOC_NAMESPACE_SEPARATOR + key;
-                if (value.is_object())
-                    stack.push_back({&value, fullKey});
-                else if (value.is_string())
-                    out[fullKey] = value.get<std::string>();
-            }
-        }
+        return a.owner.get() == b.owner.get() && a.length == b.length;
     }
 
-    // --- Internal static data -------------------------------------------------
-    inline static std::string currentLocale = DEFAULT_LOCALE; ///< Currently selected locale.
-    inline static std::unordered_map<std::string,
-                                     std::unordered_map<std::string, std::string>>
-        translations;                                                                              ///< Language code → (key → string) map.
-    inline static std::vector<std::filesystem::path> jsons;                                        ///< Loaded JSON paths.
-    inline static std::unordered_map<std::string, std::filesystem::file_time_type> fileTimestamps; ///< File timestamps.
-    inline static DebugOptions debugOptions;                                                       ///< Current debug configuration.
-#if LOC_CERR == 0
-    inline static ErrorCallback errorCallback = nullptr;
-#endif
+    friend bool operator!=(const LocString &a, const LocString &b) noexcept { return !(a == b); }
 
-public:
-#if LOC_CERR == 0
-    static void setErrorCallback(ErrorCallback cb)
+    friend std::ostream &operator<<(std::ostream &os, const LocString &s)
     {
-        LOC_WRITE_LOCK
-        errorCallback = std::move(cb);
+        return os << s.view();
     }
-#endif
+};
+
+/**
+ * @class LocWideString
+ * @brief Handle to a UTF-16 or UTF-32 copy of a catalog value.
+ *
+ * @details
+ * Like LocString, shares ownership of the catalog generation the encoded
+ * text is cached in, so the view stays valid for as long as the handle lives.
+ *
+ * @tparam Char `char16_t` or `char32_t`.
+ */
+template <class Char>
+class LocWideString
+{
+    std::shared_ptr<const Char> owner; ///< Shares ownership of the generation; points at the text.
+    std::size_t length = 0;            ///< Text length in code units.
+    bool resolved = false;             ///< Whether the key was found.
+
+public:
+    LocWideString() = default;
 
     /**
-     * @brief Loads translation data from a single JSON file.
-     * @param path Path to the JSON file.
-     * @throws std::runtime_error If the file cannot be opened or parsed.
+     * @brief Creates a handle. Used by Localizer::translateU16() / translateU32().
+     * @param owner Aliasing pointer to the text sharing ownership of its storage.
+     * @param length Text length in code units.
+     * @param found Whether the key was found.
      */
-    static void loadFromFile(const std::string &path)
+    LocWideString(std::shared_ptr<const Char> owner, std::size_t length, bool found) noexcept
+        : owner(std::move(owner)), length(length), resolved(found)
     {
-        LOC_WRITE_LOCK
-        using json = nlohmann::json;
+    }
 
-        std::ifstream file(path);
-        if (!file.is_open())
-        {
-            LOC_RAISE_ERROR("Cannot open language file: " + path, 0);
-        }
+    [[nodiscard]] std::basic_string_view<Char> view() const noexcept { return {owner.get(), length}; }
+    [[nodiscard]] const Char *data() const noexcept { return owner.get(); }
+    [[nodiscard]] std::size_t size() const noexcept { return length; }
+    [[nodiscard]] bool empty() const noexcept { return length == 0; }
+    [[nodiscard]] bool found() const noexcept { return resolved; }
 
-        json data;
-        file >> data;
+    [[nodiscard]] operator std::basic_string_view<Char>() const noexcept { return view(); }
+};
 
-        std::filesystem::path p(path);
-        std::string ns = p.stem().string();
+using LocU16String = LocWideString<char16_t>; ///< UTF-16 handle.
+using LocU32String = LocWideString<char32_t>; ///< UTF-32 handle.
 
-        fileTimestamps[path] = std::filesystem::last_write_time(p);
-        if (std::find(jsons.begin(), jsons.end(), p) == jsons.end())
-            jsons.push_back(p);
+// ============================================================================
+// LocValue
+// ============================================================================
 
-        for (auto &[lang, root] : data.items())
-        {
-            std::unordered_map<std::string, std::string> flatMap;
-            flattenJsonIterative(root, "", flatMap);
-            for (auto &[key, value] : flatMap)
-            {
-                std::string namespacedKey = ns + LOC_NAMESPACE_SEPARATOR + key;
-                translations[lang][namespacedKey] = value;
-            }
-        }
-    }
+/**
+ * @class LocValue
+ * @brief Typed (non-string) catalog leaf: a tagged scalar or an array.
+ *
+ * @details
+ * 16 bytes. Scalars are stored inline; strings and array elements point
+ * into the catalog generation, so a LocValue is a view that stays valid
+ * while that generation lives (hold a CatalogPin or a LocArray).
+ */
+class LocValue
+{
+public:
+    /// Kind of the stored value.
+    enum class Type : std::uint8_t
+    {
+        Null,
+        Bool,
+        Int,
+        Double,
+        String,
+        Array
+    };
 
-    /**
-     * @brief Loads all JSON translation files from a directory.
-     * @param folderPath Directory containing language JSONs.
-     * @param recursive Whether to include subdirectories.
-     * @throws std::runtime_error If directory does not exist.
-     */
-    static void loadFromDirectory(const std::string &folderPath, bool recursive = false)
+private:
+    union Payload
     {
-        namespace fs = std::filesystem;
-        if (!fs::exists(folderPath))
-            throw std::runtime_error("Directory not found: " + folderPath);
+        std::int64_t integer;  ///< Type::Int.
+        double number;         ///< Type::Double.
+        bool boolean;          ///< Type::Bool.
+        const char *text;      ///< Type::String.
+        const LocValue *items; ///< Type::Array.
+    };
 
-        fs::directory_options options = fs::directory_options::skip_permission_denied;
+    Payload payload{};      ///< Value or pointer into the generation.
+    std::uint32_t count = 0; ///< String bytes or array elements.
+    Type kind = Type::Null;  ///< Active payload member.
 
-        auto tryLoad = [](const fs::directory_entry &entry)
-        {
-            if (entry.is_regular_file() && entry.path().extension() == ".json")
-            {
-                try
-                {
-                    loadFromFile(entry.path().string());
-                }
-                catch (const std::exception &ex)
-                {
-                    LOC_RAISE_ERROR("[!] Failed to load " + entry.path().string() + ": " + ex.what(), 1);
-                }
-            }
-        };
+public:
+    LocValue() = default;
 
-        if (recursive)
-        {
-            for (const auto &entry : fs::recursive_directory_iterator(folderPath, options))
-                tryLoad(entry);
-        }
-        else
-        {
-            for (const auto &entry : fs::directory_iterator(folderPath, options))
-                tryLoad(entry);
-        }
+    [[nodiscard]] static LocValue fromBool(bool value) noexcept
+    {
+        LocValue v;
+        v.kind = Type::Bool;
+        v.payload.boolean = value;
+        return v;
     }
 
-    /**
-     * @brief Reloads all loaded JSON files.
-     * @param clearBefore If true, clears all existing translations before reload.
-     */
-    static void reloadAllJsons(bool clearBefore = false)
+    [[nodiscard]] static LocValue fromInt(std::int64_t value) noexcept
     {
-        LOC_WRITE_LOCK
-        if (clearBefore)
-            translations.clear();
-
-        for (const auto &json : jsons)
-        {
-            try
-            {
-                loadFromFile(json.string());
-            }
-            catch (const std::exception &ex)
-            {
-                LOC_RAISE_ERROR("[!] Failed to reload " + json.string() + ": " + ex.what(), 2);
-            }
-        }
+        LocValue v;
+        v.kind = Type::Int;
+        v.payload.integer = value;
+        return v;
     }
 
-    /**
-     * @brief Checks for modified JSON files and reloads changed ones.
-     */
-    static void checkForJsonChanges()
+    [[nodiscard]] static LocValue fromDouble(double value) noexcept
     {
-        LOC_WRITE_LOCK
-        for (auto &[path, oldTime] : fileTimestamps)
-        {
-            if (!std::filesystem::exists(path))
-                continue;
-            auto newTime = std::filesystem::last_write_time(path);
-            if (newTime != oldTime)
-            {
-                oldTime = newTime;
-                std::cout << "🔁 Detected change in " << path << std::endl;
-                loadFromFile(path);
-            }
-        }
+        LocValue v;
+        v.kind = Type::Double;
+        v.payload.number = value;
+        return v;
     }
 
-    /**
-     * @brief Sets current locale.
-     * @param locale Language code (e.g., "en", "fr").
-     * @return true if locale exists, false otherwise.
-     */
-    [[nodiscard]] static bool setLocale(const std::string &locale)
+    /// @param text Storage that outlives the value.
+    [[nodiscard]] static LocValue fromString(std::string_view text) noexcept
     {
-        LOC_WRITE_LOCK
-        if (translations.contains(locale))
-        {
-            currentLocale = locale;
-            return true;
-        }
-        return false;
+        LocValue v;
+        v.kind = Type::String;
+        v.payload.text = text.data();
+        v.count = static_cast<std::uint32_t>(text.size());
+        return v;
     }
 
-    /**
-     * @brief Retrieves current locale.
-     * @return Current locale code.
-     */
-    [[nodiscard]] static std::string getLocale() noexcept
+    /// @param items Contiguous elements that outlive the value.
+    [[nodiscard]] static LocValue fromArray(const LocValue *items, std::size_t size) noexcept
     {
-        LOC_READ_LOCK
-        return currentLocale;
+        LocValue v;
+        v.kind = Type::Array;
+        v.payload.items = items;
+        v.count = static_cast<std::uint32_t>(size);
+        return v;
     }
 
-    /**
-     * @brief Translates a key into localized text.
-     * @param key Translation key (e.g., "ui.button.play").
-     * @return Localized string or missing-key placeholder.
-     */
-    [[nodiscard]] static std::string translate(const std::string &key)
-    {
-        LOC_READ_LOCK
-        const auto &dbg = debugOptions;
-        std::string prefix;
-        if (dbg.enabled)
-        {
-            prefix = dbg.prefix;
-            if (dbg.coloredOutput)
-                prefix += dbg.keyColor + "[" + key + "]" + dbg.resetColor + " ";
-            else
-                prefix += "[" + key + "] ";
-        }
+    [[nodiscard]] Type type() const noexcept { return kind; }
 
-        if (auto it = translations[currentLocale].find(key);
-            it != translations[currentLocale].end())
-            return prefix + it->second;
+    [[nodiscard]] std::optional<bool> asBool() const noexcept
+    {
+        return kind == Type::Bool ? std::optional<bool>(payload.boolean) : std::nullopt;
+    }
 
-        if (auto it = translations[DEFAULT_LOCALE].find(key);
-            it != translations[DEFAULT_LOCALE].end())
-            return prefix + it->second;
+    [[nodiscard]] std::optional<std::int64_t> asInt() const noexcept
+    {
+        return kind == Type::Int ? std::optional<std::int64_t>(payload.integer) : std::nullopt;
+    }
 
-        std::string missing = "[Missing:" + key + "]";
-        if (dbg.enabled && dbg.coloredOutput)
-            return dbg.keyColor + missing + dbg.resetColor;
-        return missing;
+    /// Numbers of either kind, integers converted.
+    [[nodiscard]] std::optional<double> asDouble() const noexcept
+    {
+        if (kind == Type::Double)
+            return payload.number;
+        if (kind == Type::Int)
+            return static_cast<double>(payload.integer);
+        return std::nullopt;
     }
 
-    /**
-     * @brief Checks if the key exists in current or default locale.
-     * @param key Translation key.
-     * @return true if key exists.
-     */
-    [[nodiscard]] static bool hasKey(const std::string &key) noexcept
+    [[nodiscard]] std::optional<std::string_view> asString() const noexcept
     {
-        LOC_READ_LOCK
-        return translations[currentLocale].contains(key) ||
-               translations[DEFAULT_LOCALE].contains(key);
+        return kind == Type::String ? std::optional<std::string_view>(std::string_view(payload.text, count))
+                                    : std::nullopt;
     }
 
-    /**
-     * @brief Enables or disables debug mode.
-     * @param debugMode true to enable, false to disable.
+    /// Elements of an array; empty for other types.
+    [[nodiscard]] const LocValue *begin() const noexcept { return kind == Type::Array ? payload.items : nullptr; }
+    [[nodiscard]] const LocValue *end() const noexcept { return kind == Type::Array ? payload.items + count : nullptr; }
+    [[nodiscard]] std::size_t size() const noexcept { return kind == Type::Array ? count : 0; }
+    [[nodiscard]] const LocValue &operator[](std::size_t i) const noexcept { return payload.items[i]; }
+};
+
+/**
+ * @class LocArray
+ * @brief Array leaf of a catalog, sharing ownership of its generation.
+ *
+ * @details
+ * Like LocString, copying is one atomic increment and no element is ever
+ * copied; element views (including strings) stay valid while the handle lives.
+ */
+class LocArray
+{
+    std::shared_ptr<const LocValue> owner; ///< Shares ownership of the generation; points at the first element.
+    std::size_t length = 0;                ///< Number of elements.
+
+public:
+    LocArray() = default;
+
+    /**
+     * @brief Creates a handle. Used by Localizer::getArray().
+     * @param owner Aliasing pointer to the first element sharing ownership of its storage.
+     * @param length Number of elements.
+     */
+    LocArray(std::shared_ptr<const LocValue> owner, std::size_t length) noexcept
+        : owner(std::move(owner)), length(length)
+    {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return length; }
+    [[nodiscard]] bool empty() const noexcept { return length == 0; }
+    [[nodiscard]] const LocValue *begin() const noexcept { return owner.get(); }
+    [[nodiscard]] const LocValue *end() const noexcept { return owner.get() + length; }
+    [[nodiscard]] const LocValue &operator[](std::size_t i) const noexcept { return owner.get()[i]; }
+
+    /**
+     * @brief Returns a nested array element as a handle of its own.
+     * @param i Element index.
+     * @return Handle, or std::nullopt if the element is not an array.
+     */
+    [[nodiscard]] std::optional<LocArray> array(std::size_t i) const
+    {
+        const LocValue &item = (*this)[i];
+        if (item.type() != LocValue::Type::Array)
+            return std::nullopt;
+        return LocArray(std::shared_ptr<const LocValue>(owner, item.begin()), item.size());
+    }
+};
+
+// ============================================================================
+// FrameArena
+// ============================================================================
+
+/**
+ * @class FrameArena
+ * @brief Bump allocator for per-frame rendered strings.
+ *
+ * @details
+ * Allocations come from a caller-provided (or owned) buffer and spill into
+ * the upstream resource only when it is exhausted. reset() discards every
+ * allocation at once; views returned before the reset are dangling.
+ *
+ * With `LOC_FRAME_ARENA_CHECKS` (on unless `NDEBUG`), reset() overwrites
+ * the buffer with `0xDD` and, under AddressSanitizer, poisons it so that a
+ * raw read through a stale pointer is reported. Views returned by
+ * LocalizedString::render() are FrameView objects that check the arena
+ * epoch on every access.
+ */
+class FrameArena
+{
+    std::unique_ptr<std::byte[]> owned;      ///< Buffer owned by the arena, if any.
+    std::byte *buffer;                       ///< Initial buffer.
+    std::size_t capacity;                    ///< Size of the initial buffer.
+    std::pmr::monotonic_buffer_resource resource; ///< Bump allocator over `buffer`.
+    std::size_t usedBytes = 0;               ///< Bytes handed out since the last reset.
+    std::uint64_t resets = 0;                ///< Number of resets so far.
+
+public:
+    /**
+     * @brief Creates an arena over a caller-provided buffer.
+     * @param buffer Storage used before falling back to `upstream`.
+     * @param size Size of `buffer` in bytes.
+     * @param upstream Resource for overflow chunks.
+     */
+    FrameArena(void *buffer, std::size_t size,
+               std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : buffer(static_cast<std::byte *>(buffer)), capacity(size), resource(buffer, size, upstream)
+    {
+        ASAN_POISON_MEMORY_REGION(this->buffer, capacity);
+    }
+
+    /**
+     * @brief Creates an arena owning a buffer of the given size.
+     * @param size Initial buffer size in bytes.
+     * @param upstream Resource for the buffer and overflow chunks.
+     */
+    explicit FrameArena(std::size_t size = 64 * 1024,
+                        std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : owned(new std::byte[size]), buffer(owned.get()), capacity(size), resource(owned.get(), size, upstream)
+    {
+        ASAN_POISON_MEMORY_REGION(buffer, capacity);
+    }
+
+    ~FrameArena()
+    {
+        ASAN_UNPOISON_MEMORY_REGION(buffer, capacity);
+    }
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * @brief Allocates uninitialized bytes for text.
+     * @param size Number of bytes.
+     * @return Pointer valid until the next reset().
+     */
+    [[nodiscard]] char *allocate(std::size_t size)
+    {
+        char *p = static_cast<char *>(resource.allocate(size ? size : 1, 1));
+        ASAN_UNPOISON_MEMORY_REGION(p, size);
+        usedBytes += size;
+        return p;
+    }
+
+    /**
+     * @brief Releases every allocation made since the last reset.
+     */
+    void reset()
+    {
+        resource.release();
+#if LOC_FRAME_ARENA_CHECKS
+        ASAN_UNPOISON_MEMORY_REGION(buffer, capacity);
+        std::memset(buffer, 0xDD, capacity);
+#endif
+        ASAN_POISON_MEMORY_REGION(buffer, capacity);
+        usedBytes = 0;
+        ++resets;
+    }
+
+    /**
+     * @brief Returns the number of bytes allocated since the last reset.
+     */
+    [[nodiscard]] std::size_t used() const noexcept { return usedBytes; }
+
+    /**
+     * @brief Returns the number of resets performed, i.e. the current frame index.
+     */
+    [[nodiscard]] std::uint64_t epoch() const noexcept { return resets; }
+
+    /**
+     * @brief Exposes the arena as a polymorphic memory resource.
+     */
+    [[nodiscard]] std::pmr::memory_resource *memoryResource() noexcept { return &resource; }
+};
+
+/**
+ * @class FrameView
+ * @brief View of text rendered into a FrameArena.
+ *
+ * @details
+ * Behaves like a `std::string_view`. The view remembers the arena epoch it
+ * was created in; with `LOC_FRAME_ARENA_CHECKS` every access checks it:
+ * using the view after `reset()` aborts with a message, in the initial
+ * buffer and in overflow chunks alike, with or without AddressSanitizer.
+ * Converting to `std::string_view` performs the check once and drops it.
+ * The layout does not depend on the macro, so translation units built with
+ * and without the checks can exchange views.
+ */
+class FrameView
+{
+    const char *ptr = nullptr;         ///< First character.
+    std::size_t length = 0;            ///< Number of characters.
+    const FrameArena *arena = nullptr; ///< Arena the text lives in.
+    std::uint64_t stamp = 0;           ///< Arena epoch at creation.
+
+    void check() const
+    {
+#if LOC_FRAME_ARENA_CHECKS
+        if (arena && arena->epoch() != stamp)
+        {
+            std::cerr << "FrameView used after FrameArena::reset()\n";
+            std::abort();
+        }
+#endif
+    }
+
+public:
+    FrameView() noexcept = default;
+
+    /**
+     * @brief Wraps text allocated from `arena` in its current epoch.
+     * @param arena Arena owning the text.
+     * @param data First character.
+     * @param size Number of characters.
+     */
+    FrameView(const FrameArena &arena, const char *data, std::size_t size) noexcept
+        : ptr(data), length(size), arena(&arena), stamp(arena.epoch())
+    {
+    }
+
+    [[nodiscard]] const char *data() const { check(); return ptr; }
+    [[nodiscard]] std::size_t size() const { check(); return length; }
+    [[nodiscard]] bool empty() const { check(); return length == 0; }
+
+    /**
+     * @brief Returns the text as an unchecked `std::string_view`.
+     */
+    [[nodiscard]] std::string_view view() const { check(); return {ptr, length}; }
+    operator std::string_view() const { return view(); }
+
+    friend bool operator==(const FrameView &a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(const FrameView &a, std::string_view b) { return a.view() != b; }
+    friend std::ostream &operator<<(std::ostream &os, const FrameView &v) { return os << v.view(); }
+};
+
+// ============================================================================
+// RealtimeResult
+// ============================================================================
+
+/**
+ * @struct RealtimeResult
+ * @brief Outcome of Localizer::translateRealtime().
+ */
+struct RealtimeResult
+{
+    std::size_t length = 0; ///< Bytes written, excluding the terminator.
+    bool found = false;     ///< Whether the key was resolved (otherwise a missing-key marker was written).
+    bool truncated = false; ///< Whether the output did not fit into the buffer.
+};
+
+// ============================================================================
+// KeyMetadata
+// ============================================================================
+
+/**
+ * @struct KeyMetadata
+ * @brief Tooling information about one key, kept apart from the lookup tables.
+ * @see Localizer::keyMetadata()
+ */
+struct KeyMetadata
+{
+    std::string context;          ///< Translator note (`"context"` in `_meta`).
+    std::uint32_t maxLength = 0;  ///< Length hint (`"maxLength"` in `_meta`), 0 if unset.
+    std::string file;             ///< Source file that last defined the key.
+    std::uint32_t line = 0;       ///< 1-based line of the key's first definition in `file`, 0 if unknown.
+    std::uint64_t generation = 0; ///< Catalog generation that last loaded `file`.
+};
+
+// ============================================================================
+// TextMetrics
+// ============================================================================
+
+/**
+ * @struct TextMetrics
+ * @brief Display measurements of a UTF-8 text.
+ */
+struct TextMetrics
+{
+    std::uint32_t columns = 0;    ///< Terminal columns (wcwidth-like: wide CJK/emoji 2, combining marks 0).
+    std::uint32_t graphemes = 0;  ///< User-perceived characters (extended grapheme clusters).
+    std::uint32_t codePoints = 0; ///< Unicode scalar values.
+
+    TextMetrics &operator+=(const TextMetrics &other) noexcept
+    {
+        columns += other.columns;
+        graphemes += other.graphemes;
+        codePoints += other.codePoints;
+        return *this;
+    }
+
+    TextMetrics &operator-=(const TextMetrics &other) noexcept
+    {
+        columns -= other.columns;
+        graphemes -= other.graphemes;
+        codePoints -= other.codePoints;
+        return *this;
+    }
+};
+
+/**
+ * @struct MeasuredText
+ * @brief Catalog value together with its precomputed metrics.
+ */
+struct MeasuredText
+{
+    std::string_view text; ///< Value.
+    TextMetrics metrics;   ///< Metrics of `text`.
+};
+
+// ============================================================================
+// ErrorQueue
+// ============================================================================
+
+/**
+ * @struct ErrorEvent
+ * @brief Single queued error report.
+ */
+struct ErrorEvent
+{
+    std::string message; ///< Human-readable error message.
+    int code = 0;        ///< Numeric error code.
+};
+
+/**
+ * @class ErrorQueue
+ * @brief Bounded lock-free multi-producer / single-consumer queue of error events.
+ *
+ * @details
+ * Based on a sequence-numbered ring buffer: producers claim a slot with a CAS
+ * on the enqueue position and never block. When the ring is full the event is
+ * discarded and the drop counter is incremented instead.
+ *
+ * @tparam Capacity Number of slots, must be a power of two.
+ */
+template <std::size_t Capacity>
+class ErrorQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "ErrorQueue capacity must be a power of two");
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0}; ///< Slot sequence number.
+        ErrorEvent event;                     ///< Stored event.
+    };
+
+    std::array<Cell, Capacity> cells;               ///< Ring storage.
+    alignas(64) std::atomic<std::size_t> enqueuePos{0}; ///< Next producer position.
+    alignas(64) std::size_t dequeuePos = 0;         ///< Next consumer position (single consumer).
+    std::atomic<std::uint64_t> dropped{0};          ///< Events discarded because the ring was full.
+
+public:
+    ErrorQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ErrorQueue(const ErrorQueue &) = delete;
+    ErrorQueue &operator=(const ErrorQueue &) = delete;
+
+    /**
+     * @brief Enqueues an event without blocking.
+     * @param event Event to enqueue.
+     * @return false if the queue was full and the event was dropped.
+     */
+    bool push(ErrorEvent &&event) noexcept
+    {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = cells[pos & (Capacity - 1)];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.event = std::move(event);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Dequeues one event. Must only be called by a single consumer at a time.
+     * @param out Receives the event.
+     * @return true if an event was dequeued.
+     */
+    bool pop(ErrorEvent &out) noexcept
+    {
+        Cell &cell = cells[dequeuePos & (Capacity - 1)];
+        std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(dequeuePos + 1) < 0)
+            return false;
+
+        out = std::move(cell.event);
+        cell.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of events dropped because the queue was full.
+     */
+    [[nodiscard]] std::uint64_t droppedCount() const noexcept
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+};
+
+#if LOC_USE_COROUTINES
+// ============================================================================
+// Coroutine scheduling
+// ============================================================================
+
+/**
+ * @concept LocalizerScheduler
+ * @brief Minimal executor interface used by the awaitable loaders.
+ *
+ * @details
+ * Anything with `post(std::function<void()>)` that eventually runs the task
+ * qualifies: thread pools, event loops, strands, ...
+ */
+template <class S>
+concept LocalizerScheduler = requires(S &s, std::function<void()> task) {
+    s.post(std::move(task));
+};
+
+/**
+ * @struct DetachedThreadScheduler
+ * @brief Fallback scheduler running every task on its own detached thread.
+ */
+struct DetachedThreadScheduler
+{
+    void post(std::function<void()> task) const
+    {
+        std::thread(std::move(task)).detach();
+    }
+};
+#endif
+
+// ============================================================================
+// Localizer
+// ============================================================================
+
+/**
+ * @class Localizer
+ * @brief Static class for managing all localization operations.
+ *
+ * @details
+ * Provides a centralized localization manager capable of:
+ * - Loading translation files from directories.
+ * - Flattening JSON hierarchies into key-value maps.
+ * - Handling runtime reloads and file modification detection.
+ * - Performing thread-safe access to localization data.
+ */
+class CatalogPin;
+
+class Localizer
+{
+    friend class DeferredMessage;
+    friend class LocalizedString;
+    friend class CatalogPin;
+
+public:
+    static constexpr const char *DEFAULT_LOCALE = LOC_DEFAULT_LOCALE; ///< Default locale identifier.
+
+    /// Process-local interned key identifier.
+    using KeyId = std::uint32_t;
+
+    /// Process-local interned locale identifier; see internLocale().
+    using LocaleId = std::uint16_t;
+
+    /// Id of the canonical form of DEFAULT_LOCALE.
+    static constexpr LocaleId DEFAULT_LOCALE_ID = 0;
+
+    /**
+     * @brief Hashes a key with 64-bit FNV-1a.
+     *
+     * @details
+     * Unlike `std::hash`, the result does not depend on the standard library,
+     * so tables built with it stay valid when the memory is shared or mapped.
+     *
+     * @param key Key to hash.
+     * @return Hash value.
+     */
+    static constexpr std::uint64_t hashKey(std::string_view key) noexcept
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : key)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Measures display width, grapheme clusters and code points of a UTF-8 text.
+     *
+     * @details
+     * Widths follow wcwidth(): East Asian wide and fullwidth characters take
+     * two columns, combining marks, format and control characters none.
+     * Emoji joined by ZWJ count once, and a narrow pictograph followed by
+     * U+FE0F takes two columns. Grapheme clusters follow UAX #29 for the
+     * common cases (combining sequences, CR LF, Hangul syllables, emoji ZWJ
+     * sequences, flags). Invalid bytes count as U+FFFD.
+     *
+     * Catalog values are measured once when loaded; see translateMetrics().
+     *
+     * @param text UTF-8 text.
+     * @return Metrics.
+     */
+    [[nodiscard]] static TextMetrics measureText(std::string_view text) noexcept
+    {
+        enum class State : std::uint8_t
+        {
+            Start, Control, CR, Other, Pictographic, PictographicZwj, RegionalOdd, HangulL, HangulV, HangulT, HangulLV, HangulLVT
+        };
+
+        TextMetrics result;
+        State state = State::Start;
+        std::uint32_t clusterColumns = 0;
+        const auto *p = reinterpret_cast<const unsigned char *>(text.data());
+        const auto *end = p + text.size();
+        while (p < end)
+        {
+            char32_t c = decodeUtf8(p, end);
+            ++result.codePoints;
+
+            CharKind kind = classifyChar(c);
+            bool join = false;
+            switch (state)
+            {
+            case State::Start:
+            case State::Control:
+                break;
+            case State::CR:
+                join = c == U'\n';
+                break;
+            default:
+                if (kind == CharKind::Control)
+                    break;
+                join = kind == CharKind::Extend || kind == CharKind::Mark || kind == CharKind::Zwj ||
+                       (kind == CharKind::Pictographic && state == State::PictographicZwj) ||
+                       (kind == CharKind::Regional && state == State::RegionalOdd) ||
+                       (state == State::HangulL && (kind == CharKind::HangulL || kind == CharKind::HangulV ||
+                                                    kind == CharKind::HangulLV || kind == CharKind::HangulLVT)) ||
+                       ((state == State::HangulV || state == State::HangulLV) &&
+                        (kind == CharKind::HangulV || kind == CharKind::HangulT)) ||
+                       ((state == State::HangulT || state == State::HangulLVT) && kind == CharKind::HangulT);
+            }
+
+            std::uint32_t columns = charColumns(c, kind);
+            if (!join)
+            {
+                ++result.graphemes;
+                clusterColumns = 0;
+            }
+            else if (kind == CharKind::Pictographic)
+                columns = 0; // joined by ZWJ: drawn as one glyph
+            else if (c == 0xFE0F && state == State::Pictographic && clusterColumns == 1)
+                columns = 1; // emoji presentation of a narrow pictograph
+            clusterColumns += columns;
+            result.columns += columns;
+
+            switch (kind)
+            {
+            case CharKind::Control:
+                state = c == U'\r' ? State::CR : State::Control;
+                break;
+            case CharKind::Extend:
+            case CharKind::Mark:
+                state = state == State::Pictographic ? State::Pictographic : State::Other;
+                break;
+            case CharKind::Zwj:
+                state = state == State::Pictographic ? State::PictographicZwj : State::Other;
+                break;
+            case CharKind::Pictographic:
+                state = State::Pictographic;
+                break;
+            case CharKind::Regional:
+                state = join ? State::Other : State::RegionalOdd;
+                break;
+            case CharKind::HangulL:
+                state = State::HangulL;
+                break;
+            case CharKind::HangulV:
+                state = State::HangulV;
+                break;
+            case CharKind::HangulT:
+                state = State::HangulT;
+                break;
+            case CharKind::HangulLV:
+                state = State::HangulLV;
+                break;
+            case CharKind::HangulLVT:
+                state = State::HangulLVT;
+                break;
+            default:
+                state = State::Other;
+            }
+        }
+        return result;
+    }
+
+private:
+#if LOC_THREAD_SAFE
+    /**
+     * @brief Returns global shared mutex for synchronization.
+     * @return Reference to static shared_mutex.
+     */
+    static std::shared_mutex &getMutex()
+    {
+        static std::shared_mutex m;
+        return m;
+    }
+#endif
+
+    /**
+     * @struct Node
+     * @brief Internal helper structure for JSON traversal.
+     */
+    struct Node
+    {
+        const nlohmann::json *json; ///< Pointer to JSON node.
+        std::pmr::string prefix;    ///< Current namespace prefix.
+    };
+
+    /// Reserved member holding per-key metadata; never a translation.
+    static constexpr std::string_view METADATA_KEY = "_meta";
+
+    /// Reserved member turning an object into a variant set: `{ "_variants": ["A", "B"] }`.
+    static constexpr std::string_view VARIANTS_KEY = "_variants";
+
+    /**
+     * @brief Returns the variants of a JSON variant set.
+     * @param value Any JSON value.
+     * @return Non-empty array of strings, or nullptr if `value` is not a variant set.
+     */
+    static const nlohmann::json *variantsOf(const nlohmann::json &value)
+    {
+        if (!value.is_object())
+            return nullptr;
+        auto it = value.find(VARIANTS_KEY);
+        if (it == value.end() || !it->is_array() || it->empty())
+            return nullptr;
+        for (const auto &item : *it)
+            if (!item.is_string())
+                return nullptr;
+        return &*it;
+    }
+
+    /// Flattened key → value map; allocated from the caller's memory resource.
+    using FlatMap = std::pmr::unordered_map<std::pmr::string, std::pmr::string>;
+
+    /// Flattened key → typed leaf map; strings and arrays live in the map's resource.
+    using TypedMap = std::pmr::unordered_map<std::pmr::string, LocValue>;
+
+    /**
+     * @brief Copies text into an arena.
+     * @return View of the copy.
+     */
+    static std::string_view storeText(std::string_view text, std::pmr::memory_resource &arena)
+    {
+        if (text.empty())
+            return {};
+        char *buffer = static_cast<char *>(arena.allocate(text.size(), 1));
+        std::memcpy(buffer, text.data(), text.size());
+        return {buffer, text.size()};
+    }
+
+    /**
+     * @brief Converts a non-object JSON leaf into a typed value.
+     * @param value JSON scalar or array (objects inside arrays become Null).
+     * @param arena Storage for strings and array elements.
+     * @return Typed value.
+     */
+    static LocValue toLocValue(const nlohmann::json &value, std::pmr::memory_resource &arena)
+    {
+        switch (value.type())
+        {
+        case nlohmann::json::value_t::boolean:
+            return LocValue::fromBool(value.get<bool>());
+        case nlohmann::json::value_t::number_integer:
+            return LocValue::fromInt(value.get<std::int64_t>());
+        case nlohmann::json::value_t::number_unsigned:
+        {
+            auto number = value.get<std::uint64_t>();
+            return number <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())
+                       ? LocValue::fromInt(static_cast<std::int64_t>(number))
+                       : LocValue::fromDouble(static_cast<double>(number));
+        }
+        case nlohmann::json::value_t::number_float:
+            return LocValue::fromDouble(value.get<double>());
+        case nlohmann::json::value_t::string:
+            return LocValue::fromString(storeText(value.get_ref<const std::string &>(), arena));
+        case nlohmann::json::value_t::array:
+        {
+            auto *items = static_cast<LocValue *>(arena.allocate((value.size() ? value.size() : 1) * sizeof(LocValue),
+                                                                 alignof(LocValue)));
+            std::size_t i = 0;
+            for (const auto &item : value)
+                new (items + i++) LocValue(toLocValue(item, arena));
+            return LocValue::fromArray(items, value.size());
+        }
+        default:
+            return LocValue();
+        }
+    }
+
+    /**
+     * @brief Deep-copies a typed value into another arena.
+     * @param value Value to copy.
+     * @param arena Destination storage.
+     * @return Copy referencing only `arena`.
+     */
+    static LocValue copyLocValue(const LocValue &value, std::pmr::memory_resource &arena)
+    {
+        if (auto text = value.asString())
+            return LocValue::fromString(storeText(*text, arena));
+        if (value.type() != LocValue::Type::Array)
+            return value;
+        auto *items = static_cast<LocValue *>(arena.allocate((value.size() ? value.size() : 1) * sizeof(LocValue),
+                                                             alignof(LocValue)));
+        for (std::size_t i = 0; i < value.size(); ++i)
+            new (items + i) LocValue(copyLocValue(value[i], arena));
+        return LocValue::fromArray(items, value.size());
+    }
+
+    /**
+     * @brief Flattens nested JSON into a flat key-value map.
+     * @param root Root JSON object.
+     * @param basePrefix Prefix for current hierarchy.
+     * @param out Output map of flattened keys and values; its resource is used for all temporaries.
+     * @param typed Output map for number, boolean and array leaves, or nullptr to drop them.
+     * @param variants Output map for variant sets, or nullptr to keep only their first variant.
+     */
+    static void flattenJsonIterative(const nlohmann::json &root,
+                                     std::string_view basePrefix,
+                                     FlatMap &out,
+                                     TypedMap *typed = nullptr,
+                                     TypedMap *variants = nullptr)
+    {
+        std::pmr::memory_resource *resource = out.get_allocator().resource();
+        std::pmr::vector<Node> stack(resource);
+        stack.push_back({&root, std::pmr::string(basePrefix, resource)});
+        while (!stack.empty())
+        {
+            Node current = std::move(stack.back());
+            stack.pop_back();
+            for (auto &[key, value] : current.json->items())
+            {
+                if (key == METADATA_KEY)
+                    continue;
+                std::pmr::string fullKey(resource);
+                fullKey.reserve(current.prefix.size() + 1 + key.size());
+                if (!current.prefix.empty())
+                {
+                    fullKey += current.prefix;
+                    fullKey += LOC_NAMESPACE_SEPARATOR;
+                }
+                fullKey += key;
+
+                if (const nlohmann::json *set = variantsOf(value))
+                {
+                    // The first variant doubles as the plain translation.
+                    out.insert_or_assign(fullKey, std::pmr::string(set->front().get_ref<const std::string &>(), resource));
+                    if (variants)
+                        variants->insert_or_assign(std::move(fullKey), toLocValue(*set, *variants->get_allocator().resource()));
+                }
+                else if (value.is_object())
+                    stack.push_back({&value, std::move(fullKey)});
+                else if (value.is_string())
+                    out.insert_or_assign(std::move(fullKey),
+                                         std::pmr::string(value.get_ref<const std::string &>(), resource));
+                else if (typed && !value.is_null())
+                    typed->insert_or_assign(std::move(fullKey), toLocValue(value, *typed->get_allocator().resource()));
+            }
+        }
+    }
+
+    // --- Internal static data -------------------------------------------------
+    inline static LocaleId currentLocaleId = DEFAULT_LOCALE_ID; ///< Currently selected locale.
+    inline static std::atomic<std::pmr::memory_resource *> memoryResource{nullptr};               ///< Upstream for catalog storage (nullptr = default).
+    inline static std::vector<std::filesystem::path> jsons;                                        ///< Loaded JSON paths.
+    inline static std::unordered_map<std::string, std::filesystem::file_time_type> fileTimestamps; ///< File timestamps.
+    inline static std::unordered_map<std::string, std::uint64_t> fileGenerations;                 ///< Generation that last loaded each file.
+    inline static DebugOptions debugOptions;                                                       ///< Current debug configuration.
+#if LOC_CERR == 0
+    inline static ErrorCallback errorCallback = nullptr;
+#endif
+
+    // --- Key registry ----------------------------------------------------------------
+
+    /**
+     * @struct KeyRegistry
+     * @brief Append-only interning table mapping keys to small integer ids.
+     *
+     * @details
+     * Independent of the catalog lock and of catalog generations: an id stays
+     * valid for the lifetime of the process, whatever is loaded.
+     */
+    struct KeyRegistry
+    {
+#if LOC_THREAD_SAFE
+        std::shared_mutex mtx;                              ///< Guards the members below.
+#endif
+        std::deque<std::string> names;                      ///< Key text by id; elements never move.
+        std::unordered_map<std::string_view, KeyId> ids;    ///< Key text → id.
+    };
+    inline static KeyRegistry keyRegistry; ///< Interned keys.
+
+    /**
+     * @brief Looks up the id of an already interned key without interning it.
+     * @param key Translation key.
+     * @return Id, or std::nullopt if the key was never interned.
+     */
+    static std::optional<KeyId> findKeyId(std::string_view key)
+    {
+#if LOC_THREAD_SAFE
+        std::shared_lock<std::shared_mutex> guard(keyRegistry.mtx);
+#endif
+        auto it = keyRegistry.ids.find(key);
+        if (it == keyRegistry.ids.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    /**
+     * @struct MetadataTable
+     * @brief Cold key id → metadata table, kept out of the catalog generations.
+     *
+     * @details
+     * Read from the source files on first request, then kept in sync by loads
+     * while setKeyMetadataEnabled(true) is in effect. Lock order: catalog
+     * lock first, then `mtx`.
+     */
+    struct MetadataTable
+    {
+#if LOC_THREAD_SAFE
+        std::mutex mtx;                                 ///< Guards the members below.
+#endif
+        std::unordered_map<KeyId, KeyMetadata> entries; ///< Metadata by key id.
+        bool loaded;                                    ///< Whether `entries` reflects the loaded files.
+        std::uint64_t epoch;                            ///< Bumped by every commit; stale reads are discarded.
+
+        MetadataTable() : loaded(false), epoch(0) {}
+    };
+    inline static MetadataTable metadataTable;          ///< Per-key metadata.
+    inline static std::atomic<bool> metadataEnabled{false}; ///< Collect metadata while parsing.
+
+    /**
+     * @struct LocaleRegistry
+     * @brief Append-only table mapping canonical locale tags and aliases to small ids.
+     *
+     * @details
+     * Like the key registry, ids outlive catalog generations. Id 0 is always
+     * the default locale.
+     */
+    struct LocaleRegistry
+    {
+#if LOC_THREAD_SAFE
+        std::shared_mutex mtx;                               ///< Guards the members below.
+#endif
+        std::deque<std::string> texts;                       ///< Canonical tags and aliases; elements never move.
+        std::vector<std::string_view> names;                 ///< Canonical tag by id.
+        std::unordered_map<std::string_view, LocaleId> ids;  ///< Canonical tag or alias → id.
+        std::atomic<std::uint64_t> aliases{0};               ///< Aliases added so far; bumped after the insert.
+
+        LocaleRegistry()
+        {
+            names.push_back(texts.emplace_back(canonicalLocale(DEFAULT_LOCALE)));
+            ids.emplace(names.back(), DEFAULT_LOCALE_ID);
+        }
+    };
+    inline static LocaleRegistry localeRegistry; ///< Interned locales.
+
+    // --- Error delivery --------------------------------------------------------
+    inline static ErrorQueue<LOC_ERROR_QUEUE_CAPACITY> errorQueue; ///< Pending error events.
+    inline static std::mutex errorConsumerMutex;                   ///< Serializes queue consumers.
+
+    /**
+     * @struct ErrorDispatcher
+     * @brief Owns the optional background thread delivering queued errors.
+     */
+    struct ErrorDispatcher
+    {
+        std::thread worker;                 ///< Dispatcher thread.
+        std::mutex mtx;                     ///< Guards start/stop and the wake-up wait.
+        std::condition_variable cv;         ///< Wakes the dispatcher on new events.
+        std::atomic<bool> running;          ///< Whether the dispatcher thread is active.
+        std::atomic<bool> pending;          ///< Set by producers, cleared by the dispatcher.
+
+        ErrorDispatcher() : running(false), pending(false) {}
+        ~ErrorDispatcher() { stopErrorDispatcher(); }
+    };
+    inline static ErrorDispatcher errorDispatcher; ///< Background delivery state.
+
+    /**
+     * @brief Drains the error queue when a public entry point returns.
+     *
+     * @details
+     * Declared before the lock so that its destructor runs after the lock is
+     * released; user callbacks are therefore never invoked under the lock.
+     */
+    struct ErrorFlush
+    {
+        ~ErrorFlush()
+        {
+            if (!errorDispatcher.running.load(std::memory_order_acquire))
+                drainErrors();
+        }
+    };
+
+    /**
+     * @brief Pushes an error event into the queue. Never calls user code.
+     * @param message Error message.
+     * @param code Error code.
+     */
+    static void enqueueError(std::string message, int code) noexcept
+    {
+        errorQueue.push(ErrorEvent{std::move(message), code});
+        if (errorDispatcher.running.load(std::memory_order_acquire))
+        {
+            errorDispatcher.pending.store(true, std::memory_order_release);
+            errorDispatcher.cv.notify_one();
+        }
+    }
+
+    /**
+     * @brief Returns the upstream resource for catalog storage.
+     * @return User resource, or the process default resource.
+     */
+    static std::pmr::memory_resource *upstreamResource() noexcept
+    {
+        std::pmr::memory_resource *resource = memoryResource.load(std::memory_order_acquire);
+        return resource ? resource : std::pmr::get_default_resource();
+    }
+
+    /**
+     * @struct ParsedFile
+     * @brief Flattened content of one JSON file, ready to be merged into the catalog.
+     *
+     * @details
+     * All strings live in a private monotonic arena released in one shot once
+     * the file has been merged.
+     */
+    class MoFile;
+
+    struct ParsedFile
+    {
+        std::string path;                                          ///< Source path as given by the caller.
+        std::filesystem::file_time_type timestamp;                 ///< Modification time at parse.
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> arena; ///< Scratch storage for the maps below.
+        std::pmr::vector<std::pair<std::pmr::string, FlatMap>> locales; ///< Language code → namespaced key/value map.
+        std::pmr::vector<std::pair<std::pmr::string, TypedMap>> typed;  ///< Language code → typed leaves.
+        std::pmr::vector<std::pair<std::pmr::string, TypedMap>> variants; ///< Language code → variant sets (string arrays).
+        std::shared_ptr<const MoFile> mo;                           ///< Mapped catalog for `.mo` sources.
+        std::vector<std::pair<std::string, KeyMetadata>> meta;      ///< Per-key metadata of a JSON source.
+        bool metaCollected = false;                                 ///< Whether `meta` is complete (always for non-JSON sources).
+
+        explicit ParsedFile(std::pmr::memory_resource *upstream)
+            : arena(std::make_unique<std::pmr::monotonic_buffer_resource>(upstream)),
+              locales(arena.get()), typed(arena.get()), variants(arena.get())
+        {
+        }
+    };
+
+    /// Per-key metadata of one file.
+    using MetadataList = std::vector<std::pair<std::string, KeyMetadata>>;
+
+    /**
+     * @brief Reports the line of every leaf key of a JSON document.
+     *
+     * @details
+     * A tokenizer, not a parser: run it on text nlohmann::json accepted.
+     * Keys are matched by their raw spelling (escapes are not decoded) and
+     * `_meta` members are skipped.
+     *
+     * @param text JSON document.
+     * @param ns Namespace prefix of the file.
+     * @param visit Called with each namespaced key and its 1-based line.
+     */
+    template <class Visit>
+    static void scanKeyLines(std::string_view text, std::string_view ns, Visit &&visit)
+    {
+        std::vector<std::size_t> prefixes; // `path` length to restore when each open object closes
+        std::string path;
+        std::string_view key;
+        std::uint32_t line = 1;
+        std::uint32_t keyLine = 1;
+        std::size_t arrays = 0;  // nesting of the array being skipped
+        std::size_t skipped = 0; // nesting of the `_meta` object being skipped
+        bool value = false;      // between ':' and the member's value
+
+        auto leaf = [&]
+        {
+            value = false;
+            if (prefixes.size() < 2 || key == METADATA_KEY)
+                return;
+            if (key == VARIANTS_KEY && prefixes.size() > 2)
+            {
+                visit(path, keyLine); // a variant set stands for its enclosing key
+                return;
+            }
+            std::string fullKey = path;
+            if (!fullKey.empty())
+                fullKey += LOC_NAMESPACE_SEPARATOR;
+            fullKey += key;
+            visit(std::move(fullKey), keyLine);
+        };
+
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            char c = text[i];
+            if (c == '\n')
+            {
+                ++line;
+                continue;
+            }
+            if (c == '"')
+            {
+                std::size_t start = ++i;
+                for (; i < text.size() && text[i] != '"'; ++i)
+                {
+                    if (text[i] == '\\')
+                        ++i;
+                }
+                if (skipped || arrays)
+                    continue;
+                if (value)
+                    leaf();
+                else
+                {
+                    key = text.substr(start, i - start);
+                    keyLine = line;
+                }
+                continue;
+            }
+            if (skipped)
+            {
+                skipped += c == '{' ? 1 : c == '}' ? std::size_t(-1) : 0;
+                continue;
+            }
+            if (arrays)
+            {
+                arrays += c == '[' ? 1 : c == ']' ? std::size_t(-1) : 0;
+                continue;
+            }
+            switch (c)
+            {
+            case ':':
+                value = true;
+                break;
+            case '{':
+                if (value && key == METADATA_KEY)
+                {
+                    skipped = 1;
+                    value = false;
+                    break;
+                }
+                prefixes.push_back(path.size());
+                if (prefixes.size() == 2)
+                    path = ns; // a locale object
+                else if (prefixes.size() > 2)
+                {
+                    if (!path.empty())
+                        path += LOC_NAMESPACE_SEPARATOR;
+                    path += key;
+                }
+                value = false;
+                break;
+            case '}':
+                if (!prefixes.empty())
+                {
+                    path.resize(prefixes.back());
+                    prefixes.pop_back();
+                }
+                break;
+            case '[':
+                if (value)
+                    leaf();
+                arrays = 1;
+                break;
+            default:
+                if (value && !std::isspace(static_cast<unsigned char>(c)))
+                {
+                    if (c == 'n') // null leaves are not stored
+                        value = false;
+                    else
+                        leaf();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Collects key lines and `_meta` entries of a parsed JSON file.
+     *
+     * @details
+     * `_meta` may appear at the file root, with keys relative to the file
+     * namespace, or in any object of a locale, describing its siblings:
+     * `"_meta": { "title": { "context": "Window caption", "maxLength": 24 } }`.
+     *
+     * @param path Source path recorded in each entry.
+     * @param ns Namespace prefix of the file.
+     * @param text Raw file content.
+     * @param data Parsed file content.
+     * @param out Receives one entry per key.
+     */
+    static void collectMetadata(const std::string &path, std::string_view ns, std::string_view text,
+                                const nlohmann::json &data, MetadataList &out)
+    {
+        std::unordered_map<std::string, std::size_t> index;
+        auto entry = [&](std::string key) -> KeyMetadata &
+        {
+            auto [it, added] = index.try_emplace(std::move(key), out.size());
+            if (added)
+            {
+                out.emplace_back(it->first, KeyMetadata{});
+                out.back().second.file = path;
+            }
+            return out[it->second].second;
+        };
+        auto join = [](const std::string &prefix, const std::string &name)
+        {
+            return prefix.empty() ? name : prefix + LOC_NAMESPACE_SEPARATOR + name;
+        };
+
+        scanKeyLines(text, ns, [&](std::string key, std::uint32_t line)
+                     {
+                         KeyMetadata &meta = entry(std::move(key));
+                         if (!meta.line)
+                             meta.line = line;
+                     });
+
+        std::vector<std::pair<const nlohmann::json *, std::string>> stack;
+        stack.emplace_back(&data, std::string(ns));
+        bool root = true;
+        while (!stack.empty())
+        {
+            auto [node, prefix] = std::move(stack.back());
+            stack.pop_back();
+            for (const auto &[name, value] : node->items())
+            {
+                if (!value.is_object())
+                    continue;
+                if (name != METADATA_KEY)
+                {
+                    stack.emplace_back(&value, root ? prefix : join(prefix, name));
+                    continue;
+                }
+                for (const auto &[key, info] : value.items())
+                {
+                    if (!info.is_object())
+                        continue;
+                    KeyMetadata &meta = entry(join(prefix, key));
+                    if (auto it = info.find("context"); it != info.end() && it->is_string())
+                        meta.context = it->get<std::string>();
+                    if (auto it = info.find("maxLength"); it != info.end() && it->is_number_unsigned())
+                        meta.maxLength = it->get<std::uint32_t>();
+                }
+            }
+            root = false;
+        }
+    }
+
+    /**
+     * @brief Parses and flattens a JSON file. Does not touch shared state; no lock required.
+     * @param path Path to the JSON file.
+     * @param upstream Resource backing the parse arena.
+     * @return Parsed file content.
+     * @throws nlohmann::json::exception If the file cannot be parsed.
+     */
+    static ParsedFile parseFile(const std::string &path, std::pmr::memory_resource *upstream)
+    {
+        using json = nlohmann::json;
+
+        auto extension = std::filesystem::path(path).extension();
+        if (extension == ".mo")
+        {
+            ParsedFile mapped(upstream);
+            mapped.path = path;
+            mapped.timestamp = std::filesystem::last_write_time(path);
+            mapped.mo = MoFile::open(path);
+            mapped.metaCollected = true;
+            return mapped;
+        }
+        if (extension == ".csv" || extension == ".tsv")
+        {
+            ParsedFile sheet(upstream);
+            sheet.path = path;
+            sheet.timestamp = std::filesystem::last_write_time(path);
+            parseSpreadsheet(path, extension == ".tsv" ? '\t' : ',', sheet);
+            sheet.metaCollected = true;
+            return sheet;
+        }
+
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            LOC_RAISE_ERROR("Cannot open language file: " + path, 0);
+        }
+
+        std::filesystem::path p(path);
+        std::string ns = p.stem().string();
+
+        ParsedFile parsed(upstream);
+        json data;
+        if (metadataEnabled.load(std::memory_order_relaxed))
+        {
+            std::string text(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+            data = json::parse(text);
+            collectMetadata(path, ns, text, data, parsed.meta);
+            parsed.metaCollected = true;
+        }
+        else
+            file >> data;
+
+        parsed.path = path;
+        parsed.timestamp = std::filesystem::last_write_time(p);
+        for (auto &[lang, root] : data.items())
+        {
+            if (lang == METADATA_KEY)
+                continue;
+            auto &entry = parsed.locales.emplace_back(std::piecewise_construct,
+                                                      std::forward_as_tuple(lang),
+                                                      std::forward_as_tuple());
+            auto &typed = parsed.typed.emplace_back(std::piecewise_construct,
+                                                    std::forward_as_tuple(lang),
+                                                    std::forward_as_tuple());
+            auto &variants = parsed.variants.emplace_back(std::piecewise_construct,
+                                                          std::forward_as_tuple(lang),
+                                                          std::forward_as_tuple());
+            flattenJsonIterative(root, ns, entry.second, &typed.second, &variants.second);
+            if (typed.second.empty())
+                parsed.typed.pop_back();
+            if (variants.second.empty())
+                parsed.variants.pop_back();
+        }
+        return parsed;
+    }
+
+    /**
+     * @brief Streams a spreadsheet export (CSV or TSV) into a parsed file.
+     *
+     * @details
+     * The first row names the columns: a key column followed by one column
+     * per locale. Keys are namespaced by the file name like JSON keys, so
+     * `ui.csv` with a `button.play` row yields `ui.button.play`. Empty cells
+     * are skipped so the locale falls back as if the key were absent.
+     *
+     * The file is read in `LOC_CSV_CHUNK_SIZE` chunks through a quote-aware
+     * state machine (RFC 4180: quoted cells may contain delimiters, line
+     * breaks and `""` escapes); besides the parsed entries, only one chunk
+     * and the current row are held in memory.
+     *
+     * @param path File path.
+     * @param delimiter `,` or `\t`.
+     * @param parsed Receives the entries.
+     * @throws std::runtime_error If the file cannot be opened or ends inside a quoted cell.
+     */
+    static void parseSpreadsheet(const std::string &path, char delimiter, ParsedFile &parsed)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open language file: " + path);
+
+        std::pmr::memory_resource *resource = parsed.arena.get();
+        std::string ns = std::filesystem::path(path).stem().string();
+
+        enum class State
+        {
+            FieldStart,
+            Unquoted,
+            Quoted,
+            QuoteInQuoted
+        };
+        State state = State::FieldStart;
+
+        std::vector<std::string> cells(1);
+        std::size_t cell = 0;
+        std::vector<std::size_t> columns; // locale index per column, SIZE_MAX if unused
+        bool header = true;
+        std::pmr::string key(resource);
+
+        auto endField = [&]
+        {
+            if (++cell == cells.size())
+                cells.emplace_back();
+        };
+        auto endRow = [&]
+        {
+            std::size_t used = cell + 1;
+            if (header)
+            {
+                header = false;
+                parsed.locales.reserve(used);
+                columns.assign(used, std::numeric_limits<std::size_t>::max());
+                for (std::size_t i = 1; i < used; ++i)
+                {
+                    if (cells[i].empty())
+                        continue;
+                    columns[i] = parsed.locales.size();
+                    parsed.locales.emplace_back(std::piecewise_construct,
+                                                std::forward_as_tuple(cells[i]),
+                                                std::forward_as_tuple());
+                }
+            }
+            else if (!cells[0].empty())
+            {
+                key.assign(ns).append(LOC_NAMESPACE_SEPARATOR).append(cells[0]);
+                for (std::size_t i = 1; i < std::min(used, columns.size()); ++i)
+                    if (!cells[i].empty() && columns[i] != std::numeric_limits<std::size_t>::max())
+                        parsed.locales[columns[i]].second.insert_or_assign(key, std::pmr::string(cells[i], resource));
+            }
+            for (std::size_t i = 0; i < used; ++i)
+                cells[i].clear();
+            cell = 0;
+        };
+
+        std::vector<char> chunk(LOC_CSV_CHUNK_SIZE);
+        bool first = true;
+        bool rowStarted = false;
+        while (file)
+        {
+            file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            std::size_t n = static_cast<std::size_t>(file.gcount());
+            std::size_t i = 0;
+            if (first)
+            {
+                first = false;
+                if (n >= 3 && std::memcmp(chunk.data(), "\xEF\xBB\xBF", 3) == 0)
+                    i = 3;
+            }
+
+            for (; i < n; ++i)
+            {
+                char c = chunk[i];
+                switch (state)
+                {
+                case State::Quoted:
+                    if (c == '"')
+                        state = State::QuoteInQuoted;
+                    else
+                        cells[cell].push_back(c);
+                    continue;
+                case State::QuoteInQuoted:
+                    if (c == '"')
+                    {
+                        cells[cell].push_back('"');
+                        state = State::Quoted;
+                        continue;
+                    }
+                    break;
+                case State::FieldStart:
+                    if (c == '"')
+                    {
+                        state = State::Quoted;
+                        rowStarted = true;
+                        continue;
+                    }
+                    break;
+                case State::Unquoted:
+                    break;
+                }
+
+                // Outside quotes.
+                if (c == delimiter)
+                {
+                    endField();
+                    state = State::FieldStart;
+                    rowStarted = true;
+                }
+                else if (c == '\n')
+                {
+                    if (rowStarted)
+                        endRow();
+                    state = State::FieldStart;
+                    rowStarted = false;
+                }
+                else if (c != '\r')
+                {
+                    cells[cell].push_back(c);
+                    state = State::Unquoted;
+                    rowStarted = true;
+                }
+            }
+        }
+
+        if (state == State::Quoted)
+            throw std::runtime_error("Unterminated quoted cell in " + path);
+        if (rowStarted)
+            endRow();
+    }
+
+    /**
+     * @brief Parses several files, reporting failures instead of throwing.
+     * @param paths Files to parse.
+     * @param failure Message prefix for files that fail to parse.
+     * @param errorCode Error code raised for files that fail to parse.
+     * @return Successfully parsed files, in input order.
+     */
+    static std::vector<ParsedFile> parseFiles(const std::vector<std::string> &paths,
+                                              const char *failure, int errorCode)
+    {
+        std::pmr::memory_resource *upstream = upstreamResource();
+        std::vector<ParsedFile> parsed;
+        parsed.reserve(paths.size());
+        for (const auto &path : paths)
+        {
+            try
+            {
+                parsed.push_back(parseFile(path, upstream));
+            }
+            catch (const std::exception &ex)
+            {
+                LOC_RAISE_ERROR(failure + path + ": " + ex.what(), errorCode);
+            }
+        }
+        return parsed;
+    }
+
+    /**
+     * @brief Lists the JSON files of a directory.
+     * @param folderPath Directory containing language JSONs.
+     * @param recursive Whether to include subdirectories.
+     * @return Paths of all `.json`, `.mo`, `.csv` and `.tsv` files found.
+     * @throws std::runtime_error If directory does not exist.
+     */
+    static std::vector<std::string> collectJsonFiles(const std::string &folderPath, bool recursive)
+    {
+        namespace fs = std::filesystem;
+        if (!fs::exists(folderPath))
+            throw std::runtime_error("Directory not found: " + folderPath);
+
+        fs::directory_options options = fs::directory_options::skip_permission_denied;
+
+        std::vector<std::string> files;
+        auto collect = [&files](const fs::directory_entry &entry)
+        {
+            if (!entry.is_regular_file())
+                return;
+            auto extension = entry.path().extension();
+            if (extension == ".json" || extension == ".mo" || extension == ".csv" || extension == ".tsv")
+                files.push_back(entry.path().string());
+        };
+
+        if (recursive)
+        {
+            for (const auto &entry : fs::recursive_directory_iterator(folderPath, options))
+                collect(entry);
+        }
+        else
+        {
+            for (const auto &entry : fs::directory_iterator(folderPath, options))
+                collect(entry);
+        }
+        return files;
+    }
+
+    /**
+     * @brief Returns the paths of all loaded JSON files.
+     * @return Copy of the loaded path list.
+     */
+    static std::vector<std::string> loadedFiles()
+    {
+        LOC_READ_LOCK
+        std::vector<std::string> paths;
+        paths.reserve(jsons.size());
+        for (const auto &json : jsons)
+            paths.push_back(json.string());
+        return paths;
+    }
+
+    // --- gettext catalogs --------------------------------------------------------
+
+    /**
+     * @class MoFile
+     * @brief Memory-mapped gettext `.mo` catalog served through its own hash table.
+     *
+     * @details
+     * The file is mapped read-only and never parsed into the catalog: lookups
+     * hash the msgid with gettext's `hashpjw` and probe the file's hash table
+     * (or binary-search the sorted msgid table when the file has none).
+     *
+     * Keys follow the JSON scheme with the file name as namespace:
+     * `<stem>.<msgid>`, or `<stem>.<msgctxt>.<msgid>` for entries with a
+     * context. Plural entries resolve to their first form; empty
+     * translations count as missing. The locale comes from the `Language:`
+     * header field, or from a `<locale>/LC_MESSAGES/<stem>.mo` layout.
+     */
+    class MoFile
+    {
+        const unsigned char *data = nullptr; ///< File contents.
+        std::size_t length = 0;              ///< File size.
+#if defined(_WIN32)
+        std::vector<unsigned char> buffer; ///< File contents (no mmap).
+#endif
+        bool swapped = false;            ///< File byte order differs from ours.
+        std::uint32_t count = 0;         ///< Number of strings.
+        std::uint32_t originals = 0;     ///< Offset of the msgid table.
+        std::uint32_t translations = 0;  ///< Offset of the msgstr table.
+        std::uint32_t hashSize = 0;      ///< Hash table slots, 0 if absent.
+        std::uint32_t hashOffset = 0;    ///< Offset of the hash table.
+
+    public:
+        std::string path;   ///< Source path.
+        std::string ns;     ///< Key namespace (file stem).
+        std::string locale; ///< Language code served by the file.
+
+        MoFile() = default;
+        MoFile(const MoFile &) = delete;
+        MoFile &operator=(const MoFile &) = delete;
+
+        ~MoFile()
+        {
+#if !defined(_WIN32)
+            if (data)
+                ::munmap(const_cast<unsigned char *>(data), length);
+#endif
+        }
+
+        /**
+         * @brief Maps and validates a `.mo` file.
+         * @param path File path.
+         * @return Mapped catalog.
+         * @throws std::runtime_error If the file cannot be mapped or is not a valid `.mo` file.
+         */
+        static std::shared_ptr<const MoFile> open(const std::string &path)
+        {
+            auto mo = std::make_shared<MoFile>();
+#if defined(_WIN32)
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                throw std::runtime_error("Cannot open language file: " + path);
+            mo->buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            mo->data = mo->buffer.data();
+            mo->length = mo->buffer.size();
+#else
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open language file: " + path);
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size < 28)
+            {
+                ::close(fd);
+                throw std::runtime_error("Not a gettext catalog: " + path);
+            }
+            void *mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapped == MAP_FAILED)
+                throw std::runtime_error("Cannot map language file: " + path);
+            mo->data = static_cast<const unsigned char *>(mapped);
+            mo->length = static_cast<std::size_t>(st.st_size);
+#endif
+            if (!mo->validate())
+                throw std::runtime_error("Not a gettext catalog: " + path);
+
+            std::filesystem::path p(path);
+            mo->path = path;
+            mo->ns = p.stem().string();
+            mo->locale = mo->headerField("Language");
+            if (mo->locale.empty() && p.parent_path().filename() == "LC_MESSAGES")
+                mo->locale = p.parent_path().parent_path().filename().string();
+            if (mo->locale.empty())
+                throw std::runtime_error("Cannot determine the locale of " + path);
+            return mo;
+        }
+
+        /**
+         * @brief Looks up a namespaced key.
+         * @param key `<ns>.<msgid>` or `<ns>.<msgctxt>.<msgid>`.
+         * @return Translation (a view into the mapping) or std::nullopt.
+         */
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const noexcept
+        {
+            constexpr std::string_view separator = LOC_NAMESPACE_SEPARATOR;
+            if (key.size() <= ns.size() + separator.size() || key.compare(0, ns.size(), ns) != 0 ||
+                key.compare(ns.size(), separator.size(), separator) != 0)
+                return std::nullopt;
+            std::string_view rest = key.substr(ns.size() + separator.size());
+
+            if (auto value = lookup({}, rest))
+                return value;
+            for (std::size_t at = rest.find(separator); at != std::string_view::npos; at = rest.find(separator, at + 1))
+                if (auto value = lookup(rest.substr(0, at), rest.substr(at + separator.size())))
+                    return value;
+            return std::nullopt;
+        }
+
+        /// Number of translated entries (the header entry excluded).
+        [[nodiscard]] std::size_t size() const noexcept { return count ? count - 1 : 0; }
+
+    private:
+        [[nodiscard]] std::uint32_t word(std::size_t offset) const noexcept
+        {
+            std::uint32_t v;
+            std::memcpy(&v, data + offset, 4);
+            if (swapped)
+                v = (v >> 24) | ((v >> 8) & 0xff00u) | ((v << 8) & 0xff0000u) | (v << 24);
+            return v;
+        }
+
+        /// String `i` of the table at `table`: (length, offset); validated at open.
+        [[nodiscard]] std::string_view entry(std::uint32_t table, std::uint32_t i) const noexcept
+        {
+            std::uint32_t len = word(table + 8u * i);
+            std::uint32_t off = word(table + 8u * i + 4);
+            return {reinterpret_cast<const char *>(data) + off, len};
+        }
+
+        bool validate()
+        {
+            if (length < 28)
+                return false;
+            std::uint32_t magic;
+            std::memcpy(&magic, data, 4);
+            if (magic == 0xde120495u)
+                swapped = true;
+            else if (magic != 0x950412deu)
+                return false;
+            if ((word(4) >> 16) > 1)
+                return false;
+
+            count = word(8);
+            originals = word(12);
+            translations = word(16);
+            hashSize = word(20);
+            hashOffset = word(24);
+
+            auto fits = [this](std::uint64_t offset, std::uint64_t size) { return offset + size <= length; };
+            if (!fits(originals, 8ull * count) || !fits(translations, 8ull * count) ||
+                (hashSize && (hashSize < 3 || !fits(hashOffset, 4ull * hashSize))))
+                return false;
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                if (!fits(word(originals + 8u * i + 4), word(originals + 8u * i)) ||
+                    !fits(word(translations + 8u * i + 4), word(translations + 8u * i)))
+                    return false;
+            }
+            return true;
+        }
+
+        /// Value of a `Name: value` line in the header entry (msgid "").
+        [[nodiscard]] std::string headerField(std::string_view name) const
+        {
+            if (!count || !entry(originals, 0).empty())
+                return {};
+            std::string_view header = entry(translations, 0);
+            for (std::size_t pos = 0; pos < header.size();)
+            {
+                std::size_t end = header.find('\n', pos);
+                std::string_view line = header.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+                if (line.size() > name.size() && line.compare(0, name.size(), name) == 0 && line[name.size()] == ':')
+                {
+                    std::string_view value = line.substr(name.size() + 1);
+                    while (!value.empty() && value.front() == ' ')
+                        value.remove_prefix(1);
+                    while (!value.empty() && (value.back() == ' ' || value.back() == '\r'))
+                        value.remove_suffix(1);
+                    return std::string(value);
+                }
+                if (end == std::string_view::npos)
+                    break;
+                pos = end + 1;
+            }
+            return {};
+        }
+
+        /// Compares msgid `i` (up to its first NUL) with `context \x04 id`, or `id` alone.
+        [[nodiscard]] int compare(std::uint32_t i, std::string_view context, std::string_view id) const noexcept
+        {
+            std::string_view stored = entry(originals, i);
+            stored = stored.substr(0, stored.find('\0'));
+            if (!context.empty())
+            {
+                std::size_t n = std::min(stored.size(), context.size());
+                if (int c = stored.substr(0, n).compare(context.substr(0, n)))
+                    return c;
+                if (stored.size() == n)
+                    return -1;
+                if (stored[n] != '\x04')
+                    return static_cast<unsigned char>(stored[n]) < 4 ? -1 : 1;
+                stored.remove_prefix(n + 1);
+            }
+            return stored.compare(id);
+        }
+
+        [[nodiscard]] std::optional<std::string_view> translation(std::uint32_t i) const noexcept
+        {
+            std::string_view value = entry(translations, i);
+            value = value.substr(0, value.find('\0'));
+            if (value.empty())
+                return std::nullopt;
+            return value;
+        }
+
+        [[nodiscard]] std::optional<std::string_view> lookup(std::string_view context, std::string_view id) const noexcept
+        {
+            if (!count)
+                return std::nullopt;
+
+            if (!hashSize)
+            {
+                std::uint32_t lo = 0, hi = count;
+                while (lo < hi)
+                {
+                    std::uint32_t mid = lo + (hi - lo) / 2;
+                    int c = compare(mid, context, id);
+                    if (c == 0)
+                        return translation(mid);
+                    if (c < 0)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                return std::nullopt;
+            }
+
+            // gettext's hashpjw over "context \x04 id", 32-bit.
+            std::uint32_t hash = 0;
+            auto feed = [&hash](std::string_view text)
+            {
+                for (char c : text)
+                {
+                    hash = (hash << 4) + static_cast<unsigned char>(c);
+                    std::uint32_t g = hash & 0xf0000000u;
+                    if (g)
+                        hash ^= (g >> 24) ^ g;
+                }
+            };
+            if (!context.empty())
+            {
+                feed(context);
+                feed(std::string_view("\x04", 1));
+            }
+            feed(id);
+
+            std::uint32_t index = hash % hashSize;
+            std::uint32_t step = 1 + hash % (hashSize - 2);
+            for (std::uint32_t probes = 0; probes < hashSize; ++probes)
+            {
+                std::uint32_t slot = word(hashOffset + 4u * index);
+                if (slot == 0)
+                    return std::nullopt;
+                if (slot <= count && compare(slot - 1, context, id) == 0)
+                    return translation(slot - 1);
+                index = index >= hashSize - step ? index - (hashSize - step) : index + step;
+            }
+            return std::nullopt;
+        }
+    };
+
+    /// Mapped `.mo` catalogs consulted after a locale table misses, lowest precedence first.
+    using ExternalSources = std::pmr::vector<const MoFile *>;
+
+    /**
+     * @brief Looks a key up in the external sources of a table.
+     * @param sources Sources or nullptr.
+     * @param key Translation key.
+     * @return Value or std::nullopt.
+     */
+    static std::optional<std::string_view> findExternal(const ExternalSources *sources, std::string_view key) noexcept
+    {
+        if (sources)
+            for (auto it = sources->rbegin(); it != sources->rend(); ++it)
+                if (auto value = (*it)->find(key))
+                    return value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Like findExternal(), measuring the value (mapped files carry no metrics).
+     */
+    static std::optional<MeasuredText> findExternalMeasured(const ExternalSources *sources, std::string_view key) noexcept
+    {
+        if (auto value = findExternal(sources, key))
+            return MeasuredText{*value, measureText(*value)};
+        return std::nullopt;
+    }
+
+    // --- Text metrics ----------------------------------------------------------------
+
+    /// Character properties relevant to measureText().
+    enum class CharKind : std::uint8_t
+    {
+        Other, Wide, Control, Extend, Mark, Zwj, Regional, Pictographic, HangulL, HangulV, HangulT, HangulLV, HangulLVT
+    };
+
+    /// Width class of a code point range; anything not listed is narrow.
+    enum class WidthClass : std::uint8_t
+    {
+        ZERO, ///< Nonspacing, enclosing and format characters: 0 columns, extends a grapheme.
+        MARK, ///< Spacing combining marks: 1 column, extends a grapheme.
+        WIDE  ///< East Asian wide and fullwidth: 2 columns.
+    };
+
+    /// Code point range of one width class.
+    struct WidthRange
+    {
+        std::uint32_t first;   ///< First code point.
+        std::uint32_t last;    ///< Last code point (inclusive).
+        WidthClass widthClass; ///< Class of the range.
+    };
+
+    /**
+     * @brief Sorted width table, generated from Unicode 14.0
+     * (UnicodeData general categories Mn/Me/Cf/Mc, EastAsianWidth W/F).
+     */
+    static constexpr WidthRange WIDTH_RANGES[] = {
+        {0x300, 0x36F, WidthClass::ZERO}, {0x483, 0x489, WidthClass::ZERO}, {0x591, 0x5BD, WidthClass::ZERO}, {0x5BF, 0x5BF, WidthClass::ZERO}, {0x5C1, 0x5C2, WidthClass::ZERO},
+        {0x5C4, 0x5C5, WidthClass::ZERO}, {0x5C7, 0x5C7, WidthClass::ZERO}, {0x600, 0x605, WidthClass::ZERO}, {0x610, 0x61A, WidthClass::ZERO}, {0x61C, 0x61C, WidthClass::ZERO},
+        {0x64B, 0x65F, WidthClass::ZERO}, {0x670, 0x670, WidthClass::ZERO}, {0x6D6, 0x6DD, WidthClass::ZERO}, {0x6DF, 0x6E4, WidthClass::ZERO}, {0x6E7, 0x6E8, WidthClass::ZERO},
+        {0x6EA, 0x6ED, WidthClass::ZERO}, {0x70F, 0x70F, WidthClass::ZERO}, {0x711, 0x711, WidthClass::ZERO}, {0x730, 0x74A, WidthClass::ZERO}, {0x7A6, 0x7B0, WidthClass::ZERO},
+        {0x7EB, 0x7F3, WidthClass::ZERO}, {0x7FD, 0x7FD, WidthClass::ZERO}, {0x816, 0x819, WidthClass::ZERO}, {0x81B, 0x823, WidthClass::ZERO}, {0x825, 0x827, WidthClass::ZERO},
+        {0x829, 0x82D, WidthClass::ZERO}, {0x859, 0x85B, WidthClass::ZERO}, {0x890, 0x89F, WidthClass::ZERO}, {0x8CA, 0x902, WidthClass::ZERO}, {0x903, 0x903, WidthClass::MARK},
+        {0x93A, 0x93A, WidthClass::ZERO}, {0x93B, 0x93B, WidthClass::MARK}, {0x93C, 0x93C, WidthClass::ZERO}, {0x93E, 0x940, WidthClass::MARK}, {0x941, 0x948, WidthClass::ZERO},
+        {0x949, 0x94C, WidthClass::MARK}, {0x94D, 0x94D, WidthClass::ZERO}, {0x94E, 0x94F, WidthClass::MARK}, {0x951, 0x957, WidthClass::ZERO}, {0x962, 0x963, WidthClass::ZERO},
+        {0x981, 0x981, WidthClass::ZERO}, {0x982, 0x983, WidthClass::MARK}, {0x9BC, 0x9BC, WidthClass::ZERO}, {0x9BE, 0x9C0, WidthClass::MARK}, {0x9C1, 0x9C4, WidthClass::ZERO},
+        {0x9C7, 0x9CC, WidthClass::MARK}, {0x9CD, 0x9CD, WidthClass::ZERO}, {0x9D7, 0x9D7, WidthClass::MARK}, {0x9E2, 0x9E3, WidthClass::ZERO}, {0x9FE, 0xA02, WidthClass::ZERO},
+        {0xA03, 0xA03, WidthClass::MARK}, {0xA3C, 0xA3C, WidthClass::ZERO}, {0xA3E, 0xA40, WidthClass::MARK}, {0xA41, 0xA51, WidthClass::ZERO}, {0xA70, 0xA71, WidthClass::ZERO},
+        {0xA75, 0xA75, WidthClass::ZERO}, {0xA81, 0xA82, WidthClass::ZERO}, {0xA83, 0xA83, WidthClass::MARK}, {0xABC, 0xABC, WidthClass::ZERO}, {0xABE, 0xAC0, WidthClass::MARK},
+        {0xAC1, 0xAC8, WidthClass::ZERO}, {0xAC9, 0xACC, WidthClass::MARK}, {0xACD, 0xACD, WidthClass::ZERO}, {0xAE2, 0xAE3, WidthClass::ZERO}, {0xAFA, 0xB01, WidthClass::ZERO},
+        {0xB02, 0xB03, WidthClass::MARK}, {0xB3C, 0xB3C, WidthClass::ZERO}, {0xB3E, 0xB3E, WidthClass::MARK}, {0xB3F, 0xB3F, WidthClass::ZERO}, {0xB40, 0xB40, WidthClass::MARK},
+        {0xB41, 0xB44, WidthClass::ZERO}, {0xB47, 0xB4C, WidthClass::MARK}, {0xB4D, 0xB56, WidthClass::ZERO}, {0xB57, 0xB57, WidthClass::MARK}, {0xB62, 0xB63, WidthClass::ZERO},
+        {0xB82, 0xB82, WidthClass::ZERO}, {0xBBE, 0xBBF, WidthClass::MARK}, {0xBC0, 0xBC0, WidthClass::ZERO}, {0xBC1, 0xBCC, WidthClass::MARK}, {0xBCD, 0xBCD, WidthClass::ZERO},
+        {0xBD7, 0xBD7, WidthClass::MARK}, {0xC00, 0xC00, WidthClass::ZERO}, {0xC01, 0xC03, WidthClass::MARK}, {0xC04, 0xC04, WidthClass::ZERO}, {0xC3C, 0xC3C, WidthClass::ZERO},
+        {0xC3E, 0xC40, WidthClass::ZERO}, {0xC41, 0xC44, WidthClass::MARK}, {0xC46, 0xC56, WidthClass::ZERO}, {0xC62, 0xC63, WidthClass::ZERO}, {0xC81, 0xC81, WidthClass::ZERO},
+        {0xC82, 0xC83, WidthClass::MARK}, {0xCBC, 0xCBC, WidthClass::ZERO}, {0xCBE, 0xCBE, WidthClass::MARK}, {0xCBF, 0xCBF, WidthClass::ZERO}, {0xCC0, 0xCC4, WidthClass::MARK},
+        {0xCC6, 0xCC6, WidthClass::ZERO}, {0xCC7, 0xCCB, WidthClass::MARK}, {0xCCC, 0xCCD, WidthClass::ZERO}, {0xCD5, 0xCD6, WidthClass::MARK}, {0xCE2, 0xCE3, WidthClass::ZERO},
+        {0xD00, 0xD01, WidthClass::ZERO}, {0xD02, 0xD03, WidthClass::MARK}, {0xD3B, 0xD3C, WidthClass::ZERO}, {0xD3E, 0xD40, WidthClass::MARK}, {0xD41, 0xD44, WidthClass::ZERO},
+        {0xD46, 0xD4C, WidthClass::MARK}, {0xD4D, 0xD4D, WidthClass::ZERO}, {0xD57, 0xD57, WidthClass::MARK}, {0xD62, 0xD63, WidthClass::ZERO}, {0xD81, 0xD81, WidthClass::ZERO},
+        {0xD82, 0xD83, WidthClass::MARK}, {0xDCA, 0xDCA, WidthClass::ZERO}, {0xDCF, 0xDD1, WidthClass::MARK}, {0xDD2, 0xDD6, WidthClass::ZERO}, {0xDD8, 0xDDF, WidthClass::MARK},
+        {0xDF2, 0xDF3, WidthClass::MARK}, {0xE31, 0xE31, WidthClass::ZERO}, {0xE34, 0xE3A, WidthClass::ZERO}, {0xE47, 0xE4E, WidthClass::ZERO}, {0xEB1, 0xEB1, WidthClass::ZERO},
+        {0xEB4, 0xEBC, WidthClass::ZERO}, {0xEC8, 0xECD, WidthClass::ZERO}, {0xF18, 0xF19, WidthClass::ZERO}, {0xF35, 0xF35, WidthClass::ZERO}, {0xF37, 0xF37, WidthClass::ZERO},
+        {0xF39, 0xF39, WidthClass::ZERO}, {0xF3E, 0xF3F, WidthClass::MARK}, {0xF71, 0xF7E, WidthClass::ZERO}, {0xF7F, 0xF7F, WidthClass::MARK}, {0xF80, 0xF84, WidthClass::ZERO},
+        {0xF86, 0xF87, WidthClass::ZERO}, {0xF8D, 0xFBC, WidthClass::ZERO}, {0xFC6, 0xFC6, WidthClass::ZERO}, {0x102B, 0x102C, WidthClass::MARK}, {0x102D, 0x1030, WidthClass::ZERO},
+        {0x1031, 0x1031, WidthClass::MARK}, {0x1032, 0x1037, WidthClass::ZERO}, {0x1038, 0x1038, WidthClass::MARK}, {0x1039, 0x103A, WidthClass::ZERO},
+        {0x103B, 0x103C, WidthClass::MARK}, {0x103D, 0x103E, WidthClass::ZERO}, {0x1056, 0x1057, WidthClass::MARK}, {0x1058, 0x1059, WidthClass::ZERO},
+        {0x105E, 0x1060, WidthClass::ZERO}, {0x1062, 0x1064, WidthClass::MARK}, {0x1067, 0x106D, WidthClass::MARK}, {0x1071, 0x1074, WidthClass::ZERO},
+        {0x1082, 0x1082, WidthClass::ZERO}, {0x1083, 0x1084, WidthClass::MARK}, {0x1085, 0x1086, WidthClass::ZERO}, {0x1087, 0x108C, WidthClass::MARK},
+        {0x108D, 0x108D, WidthClass::ZERO}, {0x108F, 0x108F, WidthClass::MARK}, {0x109A, 0x109C, WidthClass::MARK}, {0x109D, 0x109D, WidthClass::ZERO},
+        {0x1100, 0x115F, WidthClass::WIDE}, {0x1160, 0x11FF, WidthClass::ZERO}, {0x135D, 0x135F, WidthClass::ZERO}, {0x1712, 0x1714, WidthClass::ZERO},
+        {0x1715, 0x1715, WidthClass::MARK}, {0x1732, 0x1733, WidthClass::ZERO}, {0x1734, 0x1734, WidthClass::MARK}, {0x1752, 0x1753, WidthClass::ZERO},
+        {0x1772, 0x1773, WidthClass::ZERO}, {0x17B4, 0x17B5, WidthClass::ZERO}, {0x17B6, 0x17B6, WidthClass::MARK}, {0x17B7, 0x17BD, WidthClass::ZERO},
+        {0x17BE, 0x17C5, WidthClass::MARK}, {0x17C6, 0x17C6, WidthClass::ZERO}, {0x17C7, 0x17C8, WidthClass::MARK}, {0x17C9, 0x17D3, WidthClass::ZERO},
+        {0x17DD, 0x17DD, WidthClass::ZERO}, {0x180B, 0x180F, WidthClass::ZERO}, {0x1885, 0x1886, WidthClass::ZERO}, {0x18A9, 0x18A9, WidthClass::ZERO},
+        {0x1920, 0x1922, WidthClass::ZERO}, {0x1923, 0x1926, WidthClass::MARK}, {0x1927, 0x1928, WidthClass::ZERO}, {0x1929, 0x1931, WidthClass::MARK},
+        {0x1932, 0x1932, WidthClass::ZERO}, {0x1933, 0x1938, WidthClass::MARK}, {0x1939, 0x193B, WidthClass::ZERO}, {0x1A17, 0x1A18, WidthClass::ZERO},
+        {0x1A19, 0x1A1A, WidthClass::MARK}, {0x1A1B, 0x1A1B, WidthClass::ZERO}, {0x1A55, 0x1A55, WidthClass::MARK}, {0x1A56, 0x1A56, WidthClass::ZERO},
+        {0x1A57, 0x1A57, WidthClass::MARK}, {0x1A58, 0x1A60, WidthClass::ZERO}, {0x1A61, 0x1A61, WidthClass::MARK}, {0x1A62, 0x1A62, WidthClass::ZERO},
+        {0x1A63, 0x1A64, WidthClass::MARK}, {0x1A65, 0x1A6C, WidthClass::ZERO}, {0x1A6D, 0x1A72, WidthClass::MARK}, {0x1A73, 0x1A7F, WidthClass::ZERO},
+        {0x1AB0, 0x1B03, WidthClass::ZERO}, {0x1B04, 0x1B04, WidthClass::MARK}, {0x1B34, 0x1B34, WidthClass::ZERO}, {0x1B35, 0x1B35, WidthClass::MARK},
+        {0x1B36, 0x1B3A, WidthClass::ZERO}, {0x1B3B, 0x1B3B, WidthClass::MARK}, {0x1B3C, 0x1B3C, WidthClass::ZERO}, {0x1B3D, 0x1B41, WidthClass::MARK},
+        {0x1B42, 0x1B42, WidthClass::ZERO}, {0x1B43, 0x1B44, WidthClass::MARK}, {0x1B6B, 0x1B73, WidthClass::ZERO}, {0x1B80, 0x1B81, WidthClass::ZERO},
+        {0x1B82, 0x1B82, WidthClass::MARK}, {0x1BA1, 0x1BA1, WidthClass::MARK}, {0x1BA2, 0x1BA5, WidthClass::ZERO}, {0x1BA6, 0x1BA7, WidthClass::MARK},
+        {0x1BA8, 0x1BA9, WidthClass::ZERO}, {0x1BAA, 0x1BAA, WidthClass::MARK}, {0x1BAB, 0x1BAD, WidthClass::ZERO}, {0x1BE6, 0x1BE6, WidthClass::ZERO},
+        {0x1BE7, 0x1BE7, WidthClass::MARK}, {0x1BE8, 0x1BE9, WidthClass::ZERO}, {0x1BEA, 0x1BEC, WidthClass::MARK}, {0x1BED, 0x1BED, WidthClass::ZERO},
+        {0x1BEE, 0x1BEE, WidthClass::MARK}, {0x1BEF, 0x1BF1, WidthClass::ZERO}, {0x1BF2, 0x1BF3, WidthClass::MARK}, {0x1C24, 0x1C2B, WidthClass::MARK},
+        {0x1C2C, 0x1C33, WidthClass::ZERO}, {0x1C34, 0x1C35, WidthClass::MARK}, {0x1C36, 0x1C37, WidthClass::ZERO}, {0x1CD0, 0x1CD2, WidthClass::ZERO},
+        {0x1CD4, 0x1CE0, WidthClass::ZERO}, {0x1CE1, 0x1CE1, WidthClass::MARK}, {0x1CE2, 0x1CE8, WidthClass::ZERO}, {0x1CED, 0x1CED, WidthClass::ZERO},
+        {0x1CF4, 0x1CF4, WidthClass::ZERO}, {0x1CF7, 0x1CF7, WidthClass::MARK}, {0x1CF8, 0x1CF9, WidthClass::ZERO}, {0x1DC0, 0x1DFF, WidthClass::ZERO},
+        {0x200B, 0x200C, WidthClass::ZERO}, {0x200E, 0x200F, WidthClass::ZERO}, {0x202A, 0x202E, WidthClass::ZERO}, {0x2060, 0x206F, WidthClass::ZERO},
+        {0x20D0, 0x20F0, WidthClass::ZERO}, {0x231A, 0x231B, WidthClass::WIDE}, {0x2329, 0x232A, WidthClass::WIDE}, {0x23E9, 0x23EC, WidthClass::WIDE},
+        {0x23F0, 0x23F0, WidthClass::WIDE}, {0x23F3, 0x23F3, WidthClass::WIDE}, {0x25FD, 0x25FE, WidthClass::WIDE}, {0x2614, 0x2615, WidthClass::WIDE},
+        {0x2648, 0x2653, WidthClass::WIDE}, {0x267F, 0x267F, WidthClass::WIDE}, {0x2693, 0x2693, WidthClass::WIDE}, {0x26A1, 0x26A1, WidthClass::WIDE},
+        {0x26AA, 0x26AB, WidthClass::WIDE}, {0x26BD, 0x26BE, WidthClass::WIDE}, {0x26C4, 0x26C5, WidthClass::WIDE}, {0x26CE, 0x26CE, WidthClass::WIDE},
+        {0x26D4, 0x26D4, WidthClass::WIDE}, {0x26EA, 0x26EA, WidthClass::WIDE}, {0x26F2, 0x26F3, WidthClass::WIDE}, {0x26F5, 0x26F5, WidthClass::WIDE},
+        {0x26FA, 0x26FA, WidthClass::WIDE}, {0x26FD, 0x26FD, WidthClass::WIDE}, {0x2705, 0x2705, WidthClass::WIDE}, {0x270A, 0x270B, WidthClass::WIDE},
+        {0x2728, 0x2728, WidthClass::WIDE}, {0x274C, 0x274C, WidthClass::WIDE}, {0x274E, 0x274E, WidthClass::WIDE}, {0x2753, 0x2755, WidthClass::WIDE},
+        {0x2757, 0x2757, WidthClass::WIDE}, {0x2795, 0x2797, WidthClass::WIDE}, {0x27B0, 0x27B0, WidthClass::WIDE}, {0x27BF, 0x27BF, WidthClass::WIDE},
+        {0x2B1B, 0x2B1C, WidthClass::WIDE}, {0x2B50, 0x2B50, WidthClass::WIDE}, {0x2B55, 0x2B55, WidthClass::WIDE}, {0x2CEF, 0x2CF1, WidthClass::ZERO},
+        {0x2D7F, 0x2D7F, WidthClass::ZERO}, {0x2DE0, 0x2DFF, WidthClass::ZERO}, {0x2E80, 0x3029, WidthClass::WIDE}, {0x302A, 0x302D, WidthClass::ZERO},
+        {0x302E, 0x302F, WidthClass::MARK}, {0x3030, 0x303E, WidthClass::WIDE}, {0x3041, 0x3096, WidthClass::WIDE}, {0x3099, 0x309A, WidthClass::ZERO},
+        {0x309B, 0x3247, WidthClass::WIDE}, {0x3250, 0x4DBF, WidthClass::WIDE}, {0x4E00, 0xA4C6, WidthClass::WIDE}, {0xA66F, 0xA672, WidthClass::ZERO},
+        {0xA674, 0xA67D, WidthClass::ZERO}, {0xA69E, 0xA69F, WidthClass::ZERO}, {0xA6F0, 0xA6F1, WidthClass::ZERO}, {0xA802, 0xA802, WidthClass::ZERO},
+        {0xA806, 0xA806, WidthClass::ZERO}, {0xA80B, 0xA80B, WidthClass::ZERO}, {0xA823, 0xA824, WidthClass::MARK}, {0xA825, 0xA826, WidthClass::ZERO},
+        {0xA827, 0xA827, WidthClass::MARK}, {0xA82C, 0xA82C, WidthClass::ZERO}, {0xA880, 0xA881, WidthClass::MARK}, {0xA8B4, 0xA8C3, WidthClass::MARK},
+        {0xA8C4, 0xA8C5, WidthClass::ZERO}, {0xA8E0, 0xA8F1, WidthClass::ZERO}, {0xA8FF, 0xA8FF, WidthClass::ZERO}, {0xA926, 0xA92D, WidthClass::ZERO},
+        {0xA947, 0xA951, WidthClass::ZERO}, {0xA952, 0xA953, WidthClass::MARK}, {0xA960, 0xA97C, WidthClass::WIDE}, {0xA980, 0xA982, WidthClass::ZERO},
+        {0xA983, 0xA983, WidthClass::MARK}, {0xA9B3, 0xA9B3, WidthClass::ZERO}, {0xA9B4, 0xA9B5, WidthClass::MARK}, {0xA9B6, 0xA9B9, WidthClass::ZERO},
+        {0xA9BA, 0xA9BB, WidthClass::MARK}, {0xA9BC, 0xA9BD, WidthClass::ZERO}, {0xA9BE, 0xA9C0, WidthClass::MARK}, {0xA9E5, 0xA9E5, WidthClass::ZERO},
+        {0xAA29, 0xAA2E, WidthClass::ZERO}, {0xAA2F, 0xAA30, WidthClass::MARK}, {0xAA31, 0xAA32, WidthClass::ZERO}, {0xAA33, 0xAA34, WidthClass::MARK},
+        {0xAA35, 0xAA36, WidthClass::ZERO}, {0xAA43, 0xAA43, WidthClass::ZERO}, {0xAA4C, 0xAA4C, WidthClass::ZERO}, {0xAA4D, 0xAA4D, WidthClass::MARK},
+        {0xAA7B, 0xAA7B, WidthClass::MARK}, {0xAA7C, 0xAA7C, WidthClass::ZERO}, {0xAA7D, 0xAA7D, WidthClass::MARK}, {0xAAB0, 0xAAB0, WidthClass::ZERO},
+        {0xAAB2, 0xAAB4, WidthClass::ZERO}, {0xAAB7, 0xAAB8, WidthClass::ZERO}, {0xAABE, 0xAABF, WidthClass::ZERO}, {0xAAC1, 0xAAC1, WidthClass::ZERO},
+        {0xAAEB, 0xAAEB, WidthClass::MARK}, {0xAAEC, 0xAAED, WidthClass::ZERO}, {0xAAEE, 0xAAEF, WidthClass::MARK}, {0xAAF5, 0xAAF5, WidthClass::MARK},
+        {0xAAF6, 0xAAF6, WidthClass::ZERO}, {0xABE3, 0xABE4, WidthClass::MARK}, {0xABE5, 0xABE5, WidthClass::ZERO}, {0xABE6, 0xABE7, WidthClass::MARK},
+        {0xABE8, 0xABE8, WidthClass::ZERO}, {0xABE9, 0xABEA, WidthClass::MARK}, {0xABEC, 0xABEC, WidthClass::MARK}, {0xABED, 0xABED, WidthClass::ZERO},
+        {0xAC00, 0xD7A3, WidthClass::WIDE}, {0xD7B0, 0xD7FF, WidthClass::ZERO}, {0xF900, 0xFAD9, WidthClass::WIDE}, {0xFB1E, 0xFB1E, WidthClass::ZERO},
+        {0xFE00, 0xFE0F, WidthClass::ZERO}, {0xFE10, 0xFE19, WidthClass::WIDE}, {0xFE20, 0xFE2F, WidthClass::ZERO}, {0xFE30, 0xFE6B, WidthClass::WIDE},
+        {0xFEFF, 0xFEFF, WidthClass::ZERO}, {0xFF01, 0xFF60, WidthClass::WIDE}, {0xFFE0, 0xFFE6, WidthClass::WIDE}, {0xFFF9, 0xFFFB, WidthClass::ZERO},
+        {0x101FD, 0x101FD, WidthClass::ZERO}, {0x102E0, 0x102E0, WidthClass::ZERO}, {0x10376, 0x1037A, WidthClass::ZERO}, {0x10A01, 0x10A0F, WidthClass::ZERO},
+        {0x10A38, 0x10A3F, WidthClass::ZERO}, {0x10AE5, 0x10AE6, WidthClass::ZERO}, {0x10D24, 0x10D27, WidthClass::ZERO}, {0x10EAB, 0x10EAC, WidthClass::ZERO},
+        {0x10F46, 0x10F50, WidthClass::ZERO}, {0x10F82, 0x10F85, WidthClass::ZERO}, {0x11000, 0x11000, WidthClass::MARK}, {0x11001, 0x11001, WidthClass::ZERO},
+        {0x11002, 0x11002, WidthClass::MARK}, {0x11038, 0x11046, WidthClass::ZERO}, {0x11070, 0x11070, WidthClass::ZERO}, {0x11073, 0x11074, WidthClass::ZERO},
+        {0x1107F, 0x11081, WidthClass::ZERO}, {0x11082, 0x11082, WidthClass::MARK}, {0x110B0, 0x110B2, WidthClass::MARK}, {0x110B3, 0x110B6, WidthClass::ZERO},
+        {0x110B7, 0x110B8, WidthClass::MARK}, {0x110B9, 0x110BA, WidthClass::ZERO}, {0x110BD, 0x110BD, WidthClass::ZERO}, {0x110C2, 0x110CD, WidthClass::ZERO},
+        {0x11100, 0x11102, WidthClass::ZERO}, {0x11127, 0x1112B, WidthClass::ZERO}, {0x1112C, 0x1112C, WidthClass::MARK}, {0x1112D, 0x11134, WidthClass::ZERO},
+        {0x11145, 0x11146, WidthClass::MARK}, {0x11173, 0x11173, WidthClass::ZERO}, {0x11180, 0x11181, WidthClass::ZERO}, {0x11182, 0x11182, WidthClass::MARK},
+        {0x111B3, 0x111B5, WidthClass::MARK}, {0x111B6, 0x111BE, WidthClass::ZERO}, {0x111BF, 0x111C0, WidthClass::MARK}, {0x111C9, 0x111CC, WidthClass::ZERO},
+        {0x111CE, 0x111CE, WidthClass::MARK}, {0x111CF, 0x111CF, WidthClass::ZERO}, {0x1122C, 0x1122E, WidthClass::MARK}, {0x1122F, 0x11231, WidthClass::ZERO},
+        {0x11232, 0x11233, WidthClass::MARK}, {0x11234, 0x11234, WidthClass::ZERO}, {0x11235, 0x11235, WidthClass::MARK}, {0x11236, 0x11237, WidthClass::ZERO},
+        {0x1123E, 0x1123E, WidthClass::ZERO}, {0x112DF, 0x112DF, WidthClass::ZERO}, {0x112E0, 0x112E2, WidthClass::MARK}, {0x112E3, 0x112EA, WidthClass::ZERO},
+        {0x11300, 0x11301, WidthClass::ZERO}, {0x11302, 0x11303, WidthClass::MARK}, {0x1133B, 0x1133C, WidthClass::ZERO}, {0x1133E, 0x1133F, WidthClass::MARK},
+        {0x11340, 0x11340, WidthClass::ZERO}, {0x11341, 0x1134D, WidthClass::MARK}, {0x11357, 0x11357, WidthClass::MARK}, {0x11362, 0x11363, WidthClass::MARK},
+        {0x11366, 0x11374, WidthClass::ZERO}, {0x11435, 0x11437, WidthClass::MARK}, {0x11438, 0x1143F, WidthClass::ZERO}, {0x11440, 0x11441, WidthClass::MARK},
+        {0x11442, 0x11444, WidthClass::ZERO}, {0x11445, 0x11445, WidthClass::MARK}, {0x11446, 0x11446, WidthClass::ZERO}, {0x1145E, 0x1145E, WidthClass::ZERO},
+        {0x114B0, 0x114B2, WidthClass::MARK}, {0x114B3, 0x114B8, WidthClass::ZERO}, {0x114B9, 0x114B9, WidthClass::MARK}, {0x114BA, 0x114BA, WidthClass::ZERO},
+        {0x114BB, 0x114BE, WidthClass::MARK}, {0x114BF, 0x114C0, WidthClass::ZERO}, {0x114C1, 0x114C1, WidthClass::MARK}, {0x114C2, 0x114C3, WidthClass::ZERO},
+        {0x115AF, 0x115B1, WidthClass::MARK}, {0x115B2, 0x115B5, WidthClass::ZERO}, {0x115B8, 0x115BB, WidthClass::MARK}, {0x115BC, 0x115BD, WidthClass::ZERO},
+        {0x115BE, 0x115BE, WidthClass::MARK}, {0x115BF, 0x115C0, WidthClass::ZERO}, {0x115DC, 0x115DD, WidthClass::ZERO}, {0x11630, 0x11632, WidthClass::MARK},
+        {0x11633, 0x1163A, WidthClass::ZERO}, {0x1163B, 0x1163C, WidthClass::MARK}, {0x1163D, 0x1163D, WidthClass::ZERO}, {0x1163E, 0x1163E, WidthClass::MARK},
+        {0x1163F, 0x11640, WidthClass::ZERO}, {0x116AB, 0x116AB, WidthClass::ZERO}, {0x116AC, 0x116AC, WidthClass::MARK}, {0x116AD, 0x116AD, WidthClass::ZERO},
+        {0x116AE, 0x116AF, WidthClass::MARK}, {0x116B0, 0x116B5, WidthClass::ZERO}, {0x116B6, 0x116B6, WidthClass::MARK}, {0x116B7, 0x116B7, WidthClass::ZERO},
+        {0x1171D, 0x1171F, WidthClass::ZERO}, {0x11720, 0x11721, WidthClass::MARK}, {0x11722, 0x11725, WidthClass::ZERO}, {0x11726, 0x11726, WidthClass::MARK},
+        {0x11727, 0x1172B, WidthClass::ZERO}, {0x1182C, 0x1182E, WidthClass::MARK}, {0x1182F, 0x11837, WidthClass::ZERO}, {0x11838, 0x11838, WidthClass::MARK},
+        {0x11839, 0x1183A, WidthClass::ZERO}, {0x11930, 0x11938, WidthClass::MARK}, {0x1193B, 0x1193C, WidthClass::ZERO}, {0x1193D, 0x1193D, WidthClass::MARK},
+        {0x1193E, 0x1193E, WidthClass::ZERO}, {0x11940, 0x11940, WidthClass::MARK}, {0x11942, 0x11942, WidthClass::MARK}, {0x11943, 0x11943, WidthClass::ZERO},
+        {0x119D1, 0x119D3, WidthClass::MARK}, {0x119D4, 0x119DB, WidthClass::ZERO}, {0x119DC, 0x119DF, WidthClass::MARK}, {0x119E0, 0x119E0, WidthClass::ZERO},
+        {0x119E4, 0x119E4, WidthClass::MARK}, {0x11A01, 0x11A0A, WidthClass::ZERO}, {0x11A33, 0x11A38, WidthClass::ZERO}, {0x11A39, 0x11A39, WidthClass::MARK},
+        {0x11A3B, 0x11A3E, WidthClass::ZERO}, {0x11A47, 0x11A47, WidthClass::ZERO}, {0x11A51, 0x11A56, WidthClass::ZERO}, {0x11A57, 0x11A58, WidthClass::MARK},
+        {0x11A59, 0x11A5B, WidthClass::ZERO}, {0x11A8A, 0x11A96, WidthClass::ZERO}, {0x11A97, 0x11A97, WidthClass::MARK}, {0x11A98, 0x11A99, WidthClass::ZERO},
+        {0x11C2F, 0x11C2F, WidthClass::MARK}, {0x11C30, 0x11C3D, WidthClass::ZERO}, {0x11C3E, 0x11C3E, WidthClass::MARK}, {0x11C3F, 0x11C3F, WidthClass::ZERO},
+        {0x11C92, 0x11CA7, WidthClass::ZERO}, {0x11CA9, 0x11CA9, WidthClass::MARK}, {0x11CAA, 0x11CB0, WidthClass::ZERO}, {0x11CB1, 0x11CB1, WidthClass::MARK},
+        {0x11CB2, 0x11CB3, WidthClass::ZERO}, {0x11CB4, 0x11CB4, WidthClass::MARK}, {0x11CB5, 0x11CB6, WidthClass::ZERO}, {0x11D31, 0x11D45, WidthClass::ZERO},
+        {0x11D47, 0x11D47, WidthClass::ZERO}, {0x11D8A, 0x11D8E, WidthClass::MARK}, {0x11D90, 0x11D91, WidthClass::ZERO}, {0x11D93, 0x11D94, WidthClass::MARK},
+        {0x11D95, 0x11D95, WidthClass::ZERO}, {0x11D96, 0x11D96, WidthClass::MARK}, {0x11D97, 0x11D97, WidthClass::ZERO}, {0x11EF3, 0x11EF4, WidthClass::ZERO},
+        {0x11EF5, 0x11EF6, WidthClass::MARK}, {0x13430, 0x13438, WidthClass::ZERO}, {0x16AF0, 0x16AF4, WidthClass::ZERO}, {0x16B30, 0x16B36, WidthClass::ZERO},
+        {0x16F4F, 0x16F4F, WidthClass::ZERO}, {0x16F51, 0x16F87, WidthClass::MARK}, {0x16F8F, 0x16F92, WidthClass::ZERO}, {0x16FE0, 0x16FE3, WidthClass::WIDE},
+        {0x16FE4, 0x16FE4, WidthClass::ZERO}, {0x16FF0, 0x16FF1, WidthClass::MARK}, {0x17000, 0x1B2FB, WidthClass::WIDE}, {0x1BC9D, 0x1BC9E, WidthClass::ZERO},
+        {0x1BCA0, 0x1CF46, WidthClass::ZERO}, {0x1D165, 0x1D166, WidthClass::MARK}, {0x1D167, 0x1D169, WidthClass::ZERO}, {0x1D16D, 0x1D172, WidthClass::MARK},
+        {0x1D173, 0x1D182, WidthClass::ZERO}, {0x1D185, 0x1D18B, WidthClass::ZERO}, {0x1D1AA, 0x1D1AD, WidthClass::ZERO}, {0x1D242, 0x1D244, WidthClass::ZERO},
+        {0x1DA00, 0x1DA36, WidthClass::ZERO}, {0x1DA3B, 0x1DA6C, WidthClass::ZERO}, {0x1DA75, 0x1DA75, WidthClass::ZERO}, {0x1DA84, 0x1DA84, WidthClass::ZERO},
+        {0x1DA9B, 0x1DAAF, WidthClass::ZERO}, {0x1E000, 0x1E02A, WidthClass::ZERO}, {0x1E130, 0x1E136, WidthClass::ZERO}, {0x1E2AE, 0x1E2AE, WidthClass::ZERO},
+        {0x1E2EC, 0x1E2EF, WidthClass::ZERO}, {0x1E8D0, 0x1E8D6, WidthClass::ZERO}, {0x1E944, 0x1E94A, WidthClass::ZERO}, {0x1F004, 0x1F004, WidthClass::WIDE},
+        {0x1F0CF, 0x1F0CF, WidthClass::WIDE}, {0x1F18E, 0x1F18E, WidthClass::WIDE}, {0x1F191, 0x1F19A, WidthClass::WIDE}, {0x1F200, 0x1F320, WidthClass::WIDE},
+        {0x1F32D, 0x1F335, WidthClass::WIDE}, {0x1F337, 0x1F37C, WidthClass::WIDE}, {0x1F37E, 0x1F393, WidthClass::WIDE}, {0x1F3A0, 0x1F3CA, WidthClass::WIDE},
+        {0x1F3CF, 0x1F3D3, WidthClass::WIDE}, {0x1F3E0, 0x1F3F0, WidthClass::WIDE}, {0x1F3F4, 0x1F3F4, WidthClass::WIDE}, {0x1F3F8, 0x1F3FA, WidthClass::WIDE},
+        {0x1F3FB, 0x1F3FF, WidthClass::ZERO}, {0x1F400, 0x1F43E, WidthClass::WIDE}, {0x1F440, 0x1F440, WidthClass::WIDE}, {0x1F442, 0x1F4FC, WidthClass::WIDE},
+        {0x1F4FF, 0x1F53D, WidthClass::WIDE}, {0x1F54B, 0x1F54E, WidthClass::WIDE}, {0x1F550, 0x1F567, WidthClass::WIDE}, {0x1F57A, 0x1F57A, WidthClass::WIDE},
+        {0x1F595, 0x1F596, WidthClass::WIDE}, {0x1F5A4, 0x1F5A4, WidthClass::WIDE}, {0x1F5FB, 0x1F64F, WidthClass::WIDE}, {0x1F680, 0x1F6C5, WidthClass::WIDE},
+        {0x1F6CC, 0x1F6CC, WidthClass::WIDE}, {0x1F6D0, 0x1F6D2, WidthClass::WIDE}, {0x1F6D5, 0x1F6DF, WidthClass::WIDE}, {0x1F6EB, 0x1F6EC, WidthClass::WIDE},
+        {0x1F6F4, 0x1F6FC, WidthClass::WIDE}, {0x1F7E0, 0x1F7F0, WidthClass::WIDE}, {0x1F90C, 0x1F93A, WidthClass::WIDE}, {0x1F93C, 0x1F945, WidthClass::WIDE},
+        {0x1F947, 0x1F9FF, WidthClass::WIDE}, {0x1FA70, 0x1FAF6, WidthClass::WIDE}, {0x20000, 0x3FFFD, WidthClass::WIDE}, {0xE0001, 0xE01EF, WidthClass::ZERO}
+    };
+
+    /**
+     * @brief Decodes one UTF-8 sequence and advances past it.
+     * @param p Current position, advanced by at least one byte.
+     * @param end End of the text.
+     * @return Code point, or U+FFFD for an invalid or truncated sequence.
+     */
+    static char32_t decodeUtf8(const unsigned char *&p, const unsigned char *end) noexcept
+    {
+        unsigned char lead = *p++;
+        if (lead < 0x80)
+            return lead;
+
+        std::size_t length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC2 ? 1 : 0;
+        if (!length || lead > 0xF4 || static_cast<std::size_t>(end - p) < length)
+            return 0xFFFD;
+        char32_t c = lead & (0x3F >> length);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if ((p[i] & 0xC0) != 0x80)
+                return 0xFFFD;
+            c = (c << 6) | (p[i] & 0x3F);
+        }
+        static constexpr char32_t minimum[] = {0, 0x80, 0x800, 0x10000};
+        if (c < minimum[length] || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+            return 0xFFFD;
+        p += length;
+        return c;
+    }
+
+    /**
+     * @brief Converts UTF-8 to UTF-16 or UTF-32; invalid sequences become U+FFFD.
+     * @tparam Char `char16_t` or `char32_t`.
+     * @param text UTF-8 text.
+     * @param out Destination, or nullptr to only count.
+     * @return Number of code units.
+     */
+    template <class Char>
+    static std::size_t encodeUtf8As(std::string_view text, Char *out) noexcept
+    {
+        std::size_t length = 0;
+        const auto *p = reinterpret_cast<const unsigned char *>(text.data());
+        const auto *end = p + text.size();
+        while (p < end)
+        {
+            char32_t c = decodeUtf8(p, end);
+            if (std::is_same_v<Char, char16_t> && c >= 0x10000)
+            {
+                if (out)
+                {
+                    out[length] = static_cast<Char>(0xD800 + ((c - 0x10000) >> 10));
+                    out[length + 1] = static_cast<Char>(0xDC00 + ((c - 0x10000) & 0x3FF));
+                }
+                length += 2;
+                continue;
+            }
+            if (out)
+                out[length] = static_cast<Char>(c);
+            ++length;
+        }
+        return length;
+    }
+
+    /**
+     * @brief Approximates the Extended_Pictographic property (emoji and pictographs).
+     */
+    static bool isPictographic(char32_t c) noexcept
+    {
+        if (c < 0x2000)
+            return c == 0xA9 || c == 0xAE;
+        if (c >= 0x1F000)
+            return c <= 0x1FFFD && !(c >= 0x1F1E6 && c <= 0x1F1FF) && !(c >= 0x1F3FB && c <= 0x1F3FF);
+        return c == 0x203C || c == 0x2049 || c == 0x2122 || c == 0x2139 || (c >= 0x2194 && c <= 0x2199) ||
+               c == 0x21A9 || c == 0x21AA || c == 0x231A || c == 0x231B || c == 0x2328 || c == 0x23CF ||
+               (c >= 0x23E9 && c <= 0x23F3) || (c >= 0x23F8 && c <= 0x23FA) || c == 0x24C2 || c == 0x25AA ||
+               c == 0x25AB || c == 0x25B6 || c == 0x25C0 || (c >= 0x25FB && c <= 0x25FE) ||
+               (c >= 0x2600 && c <= 0x27BF) || c == 0x2934 || c == 0x2935 || (c >= 0x2B05 && c <= 0x2B07) ||
+               c == 0x2B1B || c == 0x2B1C || c == 0x2B50 || c == 0x2B55 || c == 0x3030 || c == 0x303D ||
+               c == 0x3297 || c == 0x3299;
+    }
+
+    /**
+     * @brief Classifies a code point for width and grapheme segmentation.
+     */
+    static CharKind classifyChar(char32_t c) noexcept
+    {
+        if (c < 0x300)
+            return c < 0x20 || (c >= 0x7F && c < 0xA0) ? CharKind::Control
+                   : c == 0xA9 || c == 0xAE         ? CharKind::Pictographic
+                                                    : CharKind::Other;
+        if (c == 0x200D)
+            return CharKind::Zwj;
+        if (c >= 0x1F1E6 && c <= 0x1F1FF)
+            return CharKind::Regional;
+        if ((c >= 0x1100 && c <= 0x115F) || (c >= 0xA960 && c <= 0xA97C))
+            return CharKind::HangulL;
+        if ((c >= 0x1160 && c <= 0x11A7) || (c >= 0xD7B0 && c <= 0xD7C6))
+            return CharKind::HangulV;
+        if ((c >= 0x11A8 && c <= 0x11FF) || (c >= 0xD7CB && c <= 0xD7FB))
+            return CharKind::HangulT;
+        if (c >= 0xAC00 && c <= 0xD7A3)
+            return (c - 0xAC00) % 28 == 0 ? CharKind::HangulLV : CharKind::HangulLVT;
+        if (isPictographic(c))
+            return CharKind::Pictographic;
+
+        auto it = std::upper_bound(std::begin(WIDTH_RANGES), std::end(WIDTH_RANGES), c,
+                                   [](char32_t value, const WidthRange &range) { return value < range.first; });
+        if (it == std::begin(WIDTH_RANGES) || c > (--it)->last)
+            return CharKind::Other;
+        switch (it->widthClass)
+        {
+        case WidthClass::ZERO:
+            return CharKind::Extend;
+        case WidthClass::MARK:
+            return CharKind::Mark;
+        default:
+            return CharKind::Wide;
+        }
+    }
+
+    /**
+     * @brief Returns the column width of a classified code point.
+     */
+    static std::uint32_t charColumns(char32_t c, CharKind kind) noexcept
+    {
+        switch (kind)
+        {
+        case CharKind::Control:
+        case CharKind::Extend:
+        case CharKind::Zwj:
+        case CharKind::HangulV:
+        case CharKind::HangulT:
+            return 0;
+        case CharKind::Wide:
+        case CharKind::HangulL:
+        case CharKind::HangulLV:
+        case CharKind::HangulLVT:
+            return 2;
+        case CharKind::Pictographic:
+        {
+            auto it = std::upper_bound(std::begin(WIDTH_RANGES), std::end(WIDTH_RANGES), c,
+                                       [](char32_t value, const WidthRange &range) { return value < range.first; });
+            return it != std::begin(WIDTH_RANGES) && c <= (it - 1)->last && (it - 1)->widthClass == WidthClass::WIDE ? 2 : 1;
+        }
+        default:
+            return 1;
+        }
+    }
+
+    /// Bytes of precomputed TextMetrics stored in front of every catalog value.
+    static constexpr std::size_t METRICS_BYTES = LOC_TEXT_METRICS ? sizeof(TextMetrics) : 0;
+
+    /**
+     * @brief Writes the metrics of a value into the METRICS_BYTES in front of it.
+     * @param at Start of the metrics header.
+     * @param value Value that follows the header.
+     */
+    static void storeMetrics(char *at, std::string_view value) noexcept
+    {
+#if LOC_TEXT_METRICS
+        TextMetrics metrics = measureText(value);
+        std::memcpy(at, &metrics, sizeof(metrics));
+#else
+        (void)at;
+        (void)value;
+#endif
+    }
+
+    /**
+     * @brief Returns the metrics of a value stored by a catalog table.
+     * @param value View returned by a table (not an external source).
+     * @return Metrics, read from the header or measured when `LOC_TEXT_METRICS` is 0.
+     */
+    static TextMetrics storedMetrics(std::string_view value) noexcept
+    {
+#if LOC_TEXT_METRICS
+        TextMetrics metrics;
+        std::memcpy(&metrics, value.data() - sizeof(metrics), sizeof(metrics));
+        return metrics;
+#else
+        return measureText(value);
+#endif
+    }
+
+    /**
+     * @brief Returns the metrics of the `[Missing:key]` marker without building it.
+     */
+    static TextMetrics missingMetrics(std::string_view key) noexcept
+    {
+        TextMetrics metrics = measureText(key);
+        metrics += TextMetrics{10, 10, 10}; // "[Missing:" and "]"
+        return metrics;
+    }
+
+    /**
+     * @struct PreencodedNamespaces
+     * @brief Namespaces whose values get UTF-16/UTF-32 copies when a generation is committed.
+     */
+    struct PreencodedNamespaces
+    {
+        std::vector<std::string> prefixes; ///< Namespace followed by the separator.
+        bool utf16;                        ///< Build UTF-16 copies.
+        bool utf32;                        ///< Build UTF-32 copies.
+
+        PreencodedNamespaces() : utf16(false), utf32(false) {}
+    };
+
+    // --- Immutable catalog generations -------------------------------------------
+
+    /// Merged key → value views used while building a generation.
+    using SourceMap = std::pmr::unordered_map<std::string_view, std::string_view>;
+
+    /// Merged key → typed leaf used while building a generation.
+    using TypedSource = std::pmr::unordered_map<std::string_view, const LocValue *>;
+
+    /// Typed leaves of one locale, stored in the generation arena.
+    using TypedTable = std::pmr::unordered_map<std::string_view, LocValue>;
+
+    /// Arena bytes held by a typed value's strings and array elements.
+    static std::size_t typedValueBytes(const LocValue &value) noexcept
+    {
+        if (auto text = value.asString())
+            return text->size();
+        std::size_t bytes = value.type() == LocValue::Type::Array ? std::max<std::size_t>(value.size(), 1) * sizeof(LocValue) : 0;
+        for (const LocValue &item : value)
+            bytes += typedValueBytes(item);
+        return bytes;
+    }
+
+    /// Arena bytes buildTypedTable() needs for `source`.
+    static std::size_t typedBytesFor(const TypedSource &source) noexcept
+    {
+        // Node: next pointer, cached hash and the key/value pair; plus bucket pointers and alignment slack.
+        std::size_t bytes = source.size() * (4 * sizeof(void *) + sizeof(std::string_view) + sizeof(LocValue) + alignof(LocValue));
+        for (const auto &[key, value] : source)
+            bytes += key.size() + typedValueBytes(*value);
+        return bytes;
+    }
+
+    /**
+     * @brief Copies merged typed leaves into a generation.
+     * @param target Table in the generation arena.
+     * @param arena Generation arena.
+     * @param source Leaves to copy, or nullptr.
+     */
+    static void buildTypedTable(TypedTable &target, std::pmr::memory_resource &arena, const TypedSource *source)
+    {
+        if (!source)
+            return;
+        target.reserve(source->size());
+        for (const auto &[key, value] : *source)
+            target.emplace(storeText(key, arena), copyLocValue(*value, arena));
+    }
+
+    /**
+     * @class HashTable
+     * @brief Node-based key → value table (default layout).
+     */
+    class HashTable
+    {
+        std::pmr::unordered_map<std::string_view, std::string_view> map; ///< Views into the catalog arena.
+
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+        const ExternalSources *external = nullptr; ///< Mapped catalogs consulted on a miss.
+
+        explicit HashTable(const allocator_type &alloc) : map(alloc) {}
+        HashTable(HashTable &&other, const allocator_type &alloc)
+            : map(std::move(other.map), alloc), external(other.external) {}
+
+        /**
+         * @brief Estimates the arena bytes needed for the given entries.
+         * @param source Entries to store.
+         * @return Approximate size in bytes.
+         */
+        static std::size_t bytesFor(const SourceMap &source) noexcept
+        {
+            // Node: next pointer, cached hash and the key/value pair; plus bucket pointers with slack.
+            std::size_t bytes = source.size() * (4 * sizeof(void *) + 2 * sizeof(std::string_view) + METRICS_BYTES);
+            for (const auto &[key, value] : source)
+                bytes += key.size() + value.size();
+            return bytes;
+        }
+
+        /**
+         * @brief Fills the table, copying every key and value into the arena.
+         * @details Each value is preceded by its precomputed metrics (METRICS_BYTES).
+         * @param arena Generation arena.
+         * @param source Entries to copy.
+         */
+        void build(std::pmr::memory_resource &arena, const SourceMap &source)
+        {
+            auto store = [&arena](std::string_view text, std::size_t header) -> std::string_view
+            {
+                if (text.empty() && !header)
+                    return {};
+                char *buffer = static_cast<char *>(arena.allocate(header + text.size(), 1));
+                if (header)
+                    storeMetrics(buffer, text);
+                if (!text.empty())
+                    std::memcpy(buffer + header, text.data(), text.size());
+                return {buffer + header, text.size()};
+            };
+
+            map.reserve(source.size());
+            for (const auto &[key, value] : source)
+                map.emplace(store(key, 0), store(value, METRICS_BYTES));
+        }
+
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const noexcept
+        {
+            auto it = map.find(key);
+            if (it == map.end())
+                return findExternal(external, key);
+            return it->second;
+        }
+
+        /// Like find(key), without falling back to the mapped catalogs.
+        [[nodiscard]] std::optional<std::string_view> findOwn(std::string_view key, std::uint64_t) const noexcept
+        {
+            auto it = map.find(key);
+            if (it == map.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        /// Same as find(key); the node-based map cannot reuse a precomputed hashKey().
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key, std::uint64_t) const noexcept
+        {
+            return find(key);
+        }
+
+        /// Like find(key, hash), also returning the value's precomputed metrics.
+        [[nodiscard]] std::optional<MeasuredText> findMeasured(std::string_view key, std::uint64_t) const noexcept
+        {
+            auto it = map.find(key);
+            if (it == map.end())
+                return findExternalMeasured(external, key);
+            return MeasuredText{it->second, storedMetrics(it->second)};
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return map.size(); }
+
+        template <class F>
+        void forEach(F &&f) const
+        {
+            for (const auto &[key, value] : map)
+                f(key, value);
+        }
+    };
+
+    /**
+     * @class CompactTable
+     * @brief Offset-based key → value table (`LOC_COMPACT_CATALOG`).
+     *
+     * @details
+     * The whole table is one contiguous block:
+     * `[u32 slot × slotCount][record...]`, where each record is
+     * `[u32 keyLength][u32 valueLength][key][metrics][value]` (unaligned, read
+     * with memcpy; `metrics` is METRICS_BYTES long) and each slot holds the
+     * record offset relative to the block start. Open addressing with linear
+     * probing at a load factor of ~0.75 gives roughly 13.5 bytes of index and
+     * length overhead per entry (13.3 B measured by `catalog_memory_compact`
+     * at 1M entries). `LOC_TEXT_METRICS` therefore defaults to 0 in this
+     * layout; enabling it adds 12 bytes per entry. The block contains no
+     * pointers, so it can be copied, shared or memory-mapped as-is.
+     */
+    class CompactTable
+    {
+        static constexpr std::uint32_t EMPTY = std::numeric_limits<std::uint32_t>::max();
+
+        const unsigned char *block = nullptr; ///< Start of the table block.
+        std::uint32_t slotCount = 0;          ///< Number of hash slots.
+        std::uint32_t count = 0;              ///< Number of entries.
+
+        static std::uint32_t read32(const unsigned char *p) noexcept
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        /// Home slot of a hashKey(); the hash is remixed first because FNV-1a
+        /// barely changes its high bits when only the last characters differ.
+        [[nodiscard]] std::uint32_t home(std::uint64_t hash) const noexcept
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            return static_cast<std::uint32_t>(((hash >> 32) * slotCount) >> 32);
+        }
+
+        [[nodiscard]] std::pair<std::string_view, std::string_view> record(std::uint32_t offset) const noexcept
+        {
+            const unsigned char *p = block + offset;
+            std::uint32_t keyLength = read32(p);
+            std::uint32_t valueLength = read32(p + 4);
+            const char *text = reinterpret_cast<const char *>(p + 8);
+            return {{text, keyLength}, {text + keyLength + METRICS_BYTES, valueLength}};
+        }
+
+        static std::size_t slotsFor(std::size_t entries) noexcept
+        {
+            return entries ? entries + entries / 3 + 1 : 1;
+        }
+
+    public:
+        const ExternalSources *external = nullptr; ///< Mapped catalogs consulted on a miss.
+
+        /**
+         * @brief Computes the exact block size for the given entries.
+         * @param source Entries to store.
+         * @return Size in bytes.
+         */
+        static std::size_t bytesFor(const SourceMap &source) noexcept
+        {
+            std::size_t bytes = slotsFor(source.size()) * sizeof(std::uint32_t);
+            for (const auto &[key, value] : source)
+                bytes += 8 + METRICS_BYTES + key.size() + value.size();
+            return bytes;
+        }
+
+        /**
+         * @brief Lays out the table block in the arena.
+         * @param arena Generation arena.
+         * @param source Entries to copy.
+         * @throws std::length_error If the block would exceed 4 GiB.
+         */
+        void build(std::pmr::memory_resource &arena, const SourceMap &source)
+        {
+            count = static_cast<std::uint32_t>(source.size());
+            std::size_t slots = slotsFor(source.size());
+            std::size_t bytes = bytesFor(source);
+            if (bytes > EMPTY || slots > EMPTY)
+                throw std::length_error("Localizer: compact table exceeds 4 GiB");
+            slotCount = static_cast<std::uint32_t>(slots);
+
+            auto *out = static_cast<unsigned char *>(arena.allocate(bytes, alignof(std::uint32_t)));
+            std::memset(out, 0xFF, slots * sizeof(std::uint32_t));
+            block = out;
+
+            std::size_t cursor = slots * sizeof(std::uint32_t);
+            for (const auto &[key, value] : source)
+            {
+                auto keyLength = static_cast<std::uint32_t>(key.size());
+                auto valueLength = static_cast<std::uint32_t>(value.size());
+                std::memcpy(out + cursor, &keyLength, 4);
+                std::memcpy(out + cursor + 4, &valueLength, 4);
+                if (keyLength)
+                    std::memcpy(out + cursor + 8, key.data(), keyLength);
+                storeMetrics(reinterpret_cast<char *>(out + cursor + 8 + keyLength), value);
+                if (valueLength)
+                    std::memcpy(out + cursor + 8 + keyLength + METRICS_BYTES, value.data(), valueLength);
+
+                std::uint32_t slot = home(hashKey(key));
+                while (read32(out + slot * 4u) != EMPTY)
+                    slot = slot + 1 == slotCount ? 0 : slot + 1;
+                auto offset = static_cast<std::uint32_t>(cursor);
+                std::memcpy(out + slot * 4u, &offset, 4);
+
+                cursor += 8 + METRICS_BYTES + key.size() + value.size();
+            }
+        }
+
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const noexcept
+        {
+            return find(key, hashKey(key));
+        }
+
+        /**
+         * @brief Looks up a key whose hashKey() is already known.
+         * @param key Translation key.
+         * @param hash hashKey(key).
+         * @return Value or std::nullopt.
+         */
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key, std::uint64_t hash) const noexcept
+        {
+            if (auto value = findOwn(key, hash))
+                return value;
+            return findExternal(external, key);
+        }
+
+        /// Like find(key, hash), without falling back to the mapped catalogs.
+        [[nodiscard]] std::optional<std::string_view> findOwn(std::string_view key, std::uint64_t hash) const noexcept
+        {
+            if (!count)
+                return std::nullopt;
+            for (std::uint32_t slot = home(hash);; slot = slot + 1 == slotCount ? 0 : slot + 1)
+            {
+                std::uint32_t offset = read32(block + slot * 4u);
+                if (offset == EMPTY)
+                    return std::nullopt;
+                auto [k, v] = record(offset);
+                if (k == key)
+                    return v;
+            }
+        }
+
+        /// Like find(key, hash), also returning the value's precomputed metrics.
+        [[nodiscard]] std::optional<MeasuredText> findMeasured(std::string_view key, std::uint64_t hash) const noexcept
+        {
+            if (!count)
+                return findExternalMeasured(external, key);
+            for (std::uint32_t slot = home(hash);; slot = slot + 1 == slotCount ? 0 : slot + 1)
+            {
+                std::uint32_t offset = read32(block + slot * 4u);
+                if (offset == EMPTY)
+                    return findExternalMeasured(external, key);
+                auto [k, v] = record(offset);
+                if (k == key)
+                    return MeasuredText{v, storedMetrics(v)};
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return count; }
+
+        template <class F>
+        void forEach(F &&f) const
+        {
+            for (std::uint32_t slot = 0; slot < slotCount; ++slot)
+            {
+                std::uint32_t offset = read32(block + slot * 4u);
+                if (offset != EMPTY)
+                {
+                    auto [k, v] = record(offset);
+                    f(k, v);
+                }
+            }
+        }
+    };
+
+#if LOC_COMPACT_CATALOG
+    using Storage = CompactTable;
+#else
+    using Storage = HashTable;
+#endif
+
+    /**
+     * @class LayeredTable
+     * @brief Per-locale lookup view: overlay entries above a base table.
+     *
+     * @details
+     * Without overlays this is a plain forwarder to the base table. With
+     * overlays, a small Bloom filter over the overlaid key hashes is checked
+     * first, so keys that were not patched still cost a single probe of the
+     * base table.
+     *
+     * Keys an overlay turned into typed leaves are tombstones: the overlay's
+     * typed table shadows the base string, so lookups stop at the overlay.
+     */
+    class LayeredTable
+    {
+        const Storage *base = nullptr;          ///< Base entries, may be null.
+        const Storage *overlay = nullptr;       ///< Merged overlay entries, may be null.
+        const TypedTable *shadow = nullptr;     ///< Overlay typed leaves hiding base strings, may be null.
+        const std::uint64_t *filter = nullptr;  ///< Bloom filter over overlay and shadowed key hashes.
+        std::uint32_t filterMask = 0;           ///< Bit-index mask of `filter`.
+        std::size_t count = 0;                  ///< Number of distinct keys.
+
+        [[nodiscard]] bool maybeOverlaid(std::uint64_t hash) const noexcept
+        {
+            auto a = static_cast<std::uint32_t>(hash) & filterMask;
+            auto b = static_cast<std::uint32_t>(hash >> 32) & filterMask;
+            return (filter[a >> 6] >> (a & 63) & 1) && (filter[b >> 6] >> (b & 63) & 1);
+        }
+
+        [[nodiscard]] bool shadowed(std::string_view key) const
+        {
+            return shadow && shadow->find(key) != shadow->end();
+        }
+
+    public:
+        LayeredTable() = default;
+
+        /// View of a base table alone.
+        explicit LayeredTable(const Storage *base) : base(base), count(base ? base->size() : 0) {}
+
+        /**
+         * @brief Builds an overlay view; the filter is allocated from `arena`.
+         * @param base Base table or nullptr.
+         * @param overlay Merged overlay entries.
+         * @param shadow Overlay typed leaves whose keys hide base strings, or nullptr.
+         * @param arena Generation arena.
+         */
+        LayeredTable(const Storage *base, const Storage *overlay, const TypedTable *shadow,
+                     std::pmr::memory_resource &arena)
+            : base(base), overlay(overlay), shadow(shadow), count(base ? base->size() : 0)
+        {
+            std::size_t keys = overlay->size() + (shadow ? shadow->size() : 0);
+            std::uint32_t bits = 64;
+            while (bits < keys * 16 && bits < (1u << 24))
+                bits <<= 1;
+            auto *words = static_cast<std::uint64_t *>(arena.allocate(bits / 8, alignof(std::uint64_t)));
+            std::memset(words, 0, bits / 8);
+            filter = words;
+            filterMask = bits - 1;
+
+            auto mark = [&](std::string_view key)
+            {
+                std::uint64_t hash = hashKey(key);
+                auto a = static_cast<std::uint32_t>(hash) & filterMask;
+                auto b = static_cast<std::uint32_t>(hash >> 32) & filterMask;
+                words[a >> 6] |= std::uint64_t(1) << (a & 63);
+                words[b >> 6] |= std::uint64_t(1) << (b & 63);
+                return this->base && this->base->findOwn(key, hash);
+            };
+            overlay->forEach([&](std::string_view key, std::string_view)
+                             {
+                                 if (!mark(key))
+                                     ++count;
+                             });
+            if (shadow)
+                for (const auto &[key, value] : *shadow)
+                    if (mark(key))
+                        --count;
+        }
+
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key, std::uint64_t hash) const noexcept
+        {
+            if (overlay && maybeOverlaid(hash))
+            {
+                if (auto value = overlay->find(key, hash))
+                    return value;
+                if (shadowed(key))
+                    return std::nullopt;
+            }
+            return base ? base->find(key, hash) : std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const noexcept
+        {
+            if (!overlay)
+                return base ? base->find(key) : std::nullopt;
+            return find(key, hashKey(key));
+        }
+
+        /// Like find(key, hash), also returning the value's precomputed metrics.
+        [[nodiscard]] std::optional<MeasuredText> findMeasured(std::string_view key, std::uint64_t hash) const noexcept
+        {
+            if (overlay && maybeOverlaid(hash))
+            {
+                if (auto value = overlay->findMeasured(key, hash))
+                    return value;
+                if (shadowed(key))
+                    return std::nullopt;
+            }
+            return base ? base->findMeasured(key, hash) : std::nullopt;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return count; }
+
+        /// Mapped catalogs behind the base table, or nullptr.
+        [[nodiscard]] const ExternalSources *external() const noexcept { return base ? base->external : nullptr; }
+
+        /// Base table of this view, or nullptr.
+        [[nodiscard]] const Storage *baseTable() const noexcept { return base; }
+
+        /// Merged overlay entries of this view, or nullptr.
+        [[nodiscard]] const Storage *overlayTable() const noexcept { return overlay; }
+
+        template <class F>
+        void forEach(F &&f) const
+        {
+            if (overlay)
+                overlay->forEach(f);
+            if (base)
+                base->forEach([&](std::string_view key, std::string_view value)
+                              {
+                                  if (!overlay || (!overlay->find(key) && !shadowed(key)))
+                                      f(key, value);
+                              });
+        }
+    };
+
+    /**
+     * @struct Catalog
+     * @brief Immutable snapshot of all translations; the single owner of catalog storage.
+     *
+     * @details
+     * Keys, values and the lookup tables of one generation are allocated from
+     * a monotonic arena on top of the configured upstream resource, so the
+     * whole generation is released in one shot when its last user drops it.
+     *
+     * A generation composed with overlays owns only the overlay tables and
+     * shares the base tables of the generation it was composed from.
+     */
+    struct Catalog
+    {
+        using Table = LayeredTable;
+
+        std::pmr::monotonic_buffer_resource arena; ///< Backing storage of this generation.
+        std::uint64_t generation = 0;              ///< Monotonic generation number.
+        std::uint64_t fingerprint = 0;             ///< Hash of the default-locale keys and placeholders.
+        std::pmr::vector<std::string_view> locales; ///< Canonical locale names, parallel to `tables`.
+        std::pmr::vector<LocaleId> localeIds;       ///< Locale ids, parallel to `tables`.
+        std::pmr::vector<std::uint16_t> slots;      ///< LocaleId → index into `tables` + 1, 0 if absent.
+        std::pmr::vector<Storage> storage;          ///< Tables owned by this generation.
+        std::pmr::vector<Table> tables;             ///< Per-locale lookup views.
+        std::pmr::vector<TypedTable> typed;         ///< Per-locale typed leaves, parallel to `tables`.
+        std::pmr::vector<TypedTable> variants;      ///< Per-locale variant sets, parallel to `tables`.
+        std::shared_ptr<const Catalog> shared;      ///< Generation whose tables the views also reference.
+        std::pmr::vector<std::shared_ptr<const MoFile>> moFiles; ///< Mapped `.mo` catalogs, load order.
+        std::pmr::vector<ExternalSources> external;  ///< Per-locale views of `moFiles`, parallel to `storage`.
+
+        mutable std::once_flag hashIndexOnce;                                  ///< Guards lazy construction of `hashIndex`.
+        mutable std::unordered_map<std::uint64_t, std::string_view> hashIndex; ///< hashKey(key) → key, built on first use.
+
+        /**
+         * @struct WideCache
+         * @brief UTF-16/UTF-32 copies of values, keyed by the address of the UTF-8 value.
+         *
+         * @details
+         * Filled on demand (or eagerly, see setPreencodedNamespaces()) and
+         * released with the generation. Has its own arena and lock because
+         * the generation itself is immutable once published.
+         */
+        struct WideCache
+        {
+#if LOC_THREAD_SAFE
+            std::shared_mutex mtx;                                        ///< Guards the members below.
+#endif
+            std::pmr::monotonic_buffer_resource arena;                    ///< Storage of the encoded texts.
+            std::unordered_map<const char *, std::u16string_view> u16;    ///< UTF-16 copies.
+            std::unordered_map<const char *, std::u32string_view> u32;    ///< UTF-32 copies.
+            bool preencoded = false;                                      ///< Preencoded namespaces done (catalog write lock).
+
+            explicit WideCache(std::pmr::memory_resource *upstream) : arena(upstream) {}
+        };
+        mutable WideCache wide; ///< Encoded views of this generation's values.
+
+        /**
+         * @brief Creates an empty catalog.
+         * @param upstream Resource the arena draws from.
+         * @param initialSize Expected arena size in bytes.
+         */
+        Catalog(std::pmr::memory_resource *upstream, std::size_t initialSize)
+            : arena(initialSize ? initialSize : 1024, upstream), locales(&arena), localeIds(&arena), slots(&arena),
+              storage(&arena), tables(&arena), typed(&arena), variants(&arena), moFiles(&arena), external(&arena), wide(upstream)
+        {
+        }
+
+        /**
+         * @brief Returns the UTF-16 or UTF-32 copy of a value, encoding it on first use.
+         * @tparam Char `char16_t` or `char32_t`.
+         * @param value View returned by one of this generation's tables.
+         * @return Encoded text, valid for the lifetime of the generation.
+         */
+        template <class Char>
+        std::basic_string_view<Char> encoded(std::string_view value) const
+        {
+            if (shared)
+            {
+                // Base values keep their address, so the shared generation's copies apply here too.
+                auto &inherited = shared->wideMap<Char>();
+#if LOC_THREAD_SAFE
+                std::shared_lock<std::shared_mutex> guard(shared->wide.mtx);
+#endif
+                if (auto it = inherited.find(value.data()); it != inherited.end())
+                    return it->second;
+            }
+
+            auto &map = wideMap<Char>();
+            {
+#if LOC_THREAD_SAFE
+                std::shared_lock<std::shared_mutex> guard(wide.mtx);
+#endif
+                if (auto it = map.find(value.data()); it != map.end())
+                    return it->second;
+            }
+
+            std::size_t length = encodeUtf8As<Char>(value, nullptr);
+#if LOC_THREAD_SAFE
+            std::unique_lock<std::shared_mutex> guard(wide.mtx);
+#endif
+            if (auto it = map.find(value.data()); it != map.end())
+                return it->second;
+            auto *text = static_cast<Char *>(wide.arena.allocate((length ? length : 1) * sizeof(Char), alignof(Char)));
+            encodeUtf8As<Char>(value, text);
+            return map.emplace(value.data(), std::basic_string_view<Char>(text, length)).first->second;
+        }
+
+        /// Cache map for the given code unit type.
+        template <class Char>
+        auto &wideMap() const noexcept
+        {
+            if constexpr (std::is_same_v<Char, char16_t>)
+                return wide.u16;
+            else
+                return wide.u32;
+        }
+
+        Catalog(const Catalog &) = delete;
+        Catalog &operator=(const Catalog &) = delete;
+
+        /**
+         * @brief Records a locale; its table is appended separately at the same position.
+         * @param id Interned locale.
+         */
+        void addLocaleName(LocaleId id)
+        {
+            localeIds.push_back(id);
+            locales.push_back(localeName(id)); // registry names live for the whole process
+        }
+
+        /**
+         * @brief Appends a locale table built from merged entries.
+         * @param id Interned locale.
+         * @param source Entries of the locale.
+         */
+        void addLocale(LocaleId id, const SourceMap &source)
+        {
+            addLocaleName(id);
+            storage.emplace_back().build(arena, source);
+        }
+
+        /**
+         * @brief Creates one plain view per owned table, once all tables are built.
+         */
+        void linkTables()
+        {
+            tables.reserve(storage.size());
+            for (const Storage &table : storage)
+                tables.emplace_back(&table);
+            indexLocales();
+        }
+
+        /**
+         * @brief Builds the id → table index once `localeIds` is complete.
+         */
+        void indexLocales()
+        {
+            LocaleId top = 0;
+            for (LocaleId id : localeIds)
+                top = std::max(top, id);
+            slots.assign(localeIds.empty() ? 0 : std::size_t(top) + 1, 0);
+            for (std::size_t i = 0; i < localeIds.size(); ++i)
+                slots[localeIds[i]] = static_cast<std::uint16_t>(i + 1);
+        }
+
+        /**
+         * @brief Returns the table for an interned locale.
+         * @param id Locale id.
+         * @return Pointer to the table or nullptr.
+         */
+        [[nodiscard]] const Table *table(LocaleId id) const noexcept
+        {
+            return id < slots.size() && slots[id] ? &tables[slots[id] - 1] : nullptr;
+        }
+
+        /**
+         * @brief Looks a key up in one of the per-locale side tables, then in `shared`.
+         * An overlay string, typed leaf or variant set of this generation
+         * shadows the shared generation's entry.
+         */
+        [[nodiscard]] const LocValue *findLeaf(std::pmr::vector<TypedTable> Catalog::*member, LocaleId id,
+                                               std::string_view key) const
+        {
+            const std::pmr::vector<TypedTable> &sides = this->*member;
+            if (id < slots.size() && slots[id] && slots[id] <= sides.size())
+            {
+                std::size_t index = slots[id] - 1;
+                const TypedTable &values = sides[index];
+                if (auto it = values.find(key); it != values.end())
+                    return &it->second;
+                const std::pmr::vector<TypedTable> &others = member == &Catalog::typed ? variants : typed;
+                if (index < others.size() && others[index].find(key) != others[index].end())
+                    return nullptr;
+                if (const Storage *overlay = tables[index].overlayTable(); overlay && overlay->find(key))
+                    return nullptr;
+            }
+            return shared ? shared->findLeaf(member, id, key) : nullptr;
+        }
+
+        /**
+         * @brief Finds a typed leaf, consulting the generation this one was composed from.
+         * @param id Locale id.
+         * @param key Translation key.
+         * @return Value (owned by this generation or `shared`) or nullptr.
+         */
+        [[nodiscard]] const LocValue *findTyped(LocaleId id, std::string_view key) const
+        {
+            return findLeaf(&Catalog::typed, id, key);
+        }
+
+        /// @copydoc findTyped(LocaleId, std::string_view) const
+        [[nodiscard]] const LocValue *findTyped(std::string_view locale, std::string_view key) const
+        {
+            for (std::size_t i = 0; i < locales.size(); ++i)
+                if (locales[i] == locale)
+                    return findTyped(localeIds[i], key);
+            std::optional<LocaleId> id = findLocaleId(locale);
+            return id ? findTyped(*id, key) : nullptr;
+        }
+
+        /**
+         * @brief Finds a variant set (array of strings), consulting the generation this one was composed from.
+         * @param id Locale id.
+         * @param key Translation key.
+         * @return Variants (owned by this generation or `shared`) or nullptr.
+         */
+        [[nodiscard]] const LocValue *findVariants(LocaleId id, std::string_view key) const
+        {
+            return findLeaf(&Catalog::variants, id, key);
+        }
+
+        /// @copydoc findVariants(LocaleId, std::string_view) const
+        [[nodiscard]] const LocValue *findVariants(std::string_view locale, std::string_view key) const
+        {
+            for (std::size_t i = 0; i < locales.size(); ++i)
+                if (locales[i] == locale)
+                    return findVariants(localeIds[i], key);
+            std::optional<LocaleId> id = findLocaleId(locale);
+            return id ? findVariants(*id, key) : nullptr;
+        }
+
+        /**
+         * @brief Finds a variant set, falling back to the default locale.
+         * A plain string stored under the key in `locale` hides the default-locale set.
+         * @param locale Language code or LocaleId.
+         * @param key Translation key.
+         * @return Variants or nullptr.
+         */
+        template <class Locale>
+        [[nodiscard]] const LocValue *resolveVariants(const Locale &locale, std::string_view key) const
+        {
+            if (const LocValue *set = findVariants(locale, key))
+                return set;
+            if (const Table *strings = table(locale); strings && strings->find(key))
+                return nullptr;
+            return findVariants(DEFAULT_LOCALE_ID, key);
+        }
+
+        /**
+         * @brief Finds a typed leaf, falling back to the default locale.
+         * A string stored under the key in `locale` hides the default-locale leaf.
+         * @param locale Language code or LocaleId.
+         * @param key Translation key.
+         * @return Value or nullptr.
+         */
+        template <class Locale>
+        [[nodiscard]] const LocValue *resolveTyped(const Locale &locale, std::string_view key) const
+        {
+            if (const LocValue *value = findTyped(locale, key))
+                return value;
+            if (const Table *strings = table(locale); strings && strings->find(key))
+                return nullptr;
+            return findTyped(DEFAULT_LOCALE_ID, key);
+        }
+
+        /**
+         * @brief Returns the table for a locale tag in any spelling ("en_us", "iw", ...).
+         * @param locale Language code.
+         * @return Pointer to the table or nullptr.
+         */
+        [[nodiscard]] const Table *table(std::string_view locale) const
+        {
+            for (std::size_t i = 0; i < locales.size(); ++i)
+                if (locales[i] == locale)
+                    return &tables[i];
+            std::optional<LocaleId> id = findLocaleId(locale);
+            return id ? table(*id) : nullptr;
+        }
+
+        /**
+         * @brief Finds a key of any locale by its hashKey() value.
+         * @param hash Key hash.
+         * @return Key or std::nullopt.
+         */
+        [[nodiscard]] std::optional<std::string_view> keyForHash(std::uint64_t hash) const
+        {
+            std::call_once(hashIndexOnce, [this]
+                           {
+                               for (const Storage &t : storage)
+                                   t.forEach([this](std::string_view key, std::string_view)
+                                             { hashIndex.emplace(hashKey(key), key); });
+                           });
+            auto it = hashIndex.find(hash);
+            if (it == hashIndex.end())
+                return shared ? shared->keyForHash(hash) : std::nullopt;
+            return it->second;
+        }
+    };
+
+    /**
+     * @brief Calls `f(name)` for every `{name}` placeholder in a text.
+     * @param text Translation text.
+     * @param f Callback.
+     */
+    template <class F>
+    static void forEachPlaceholder(std::string_view text, F &&f)
+    {
+        for (std::size_t open = text.find('{'); open != std::string_view::npos; open = text.find('{', open + 1))
+        {
+            auto close = text.find('}', open + 1);
+            if (close == std::string_view::npos)
+                return;
+            f(text.substr(open + 1, close - open - 1));
+            open = close;
+        }
+    }
+
+    /**
+     * @brief Computes the wire fingerprint of a catalog.
+     *
+     * @details
+     * Covers the keys of the default locale and the placeholder names of
+     * their values, i.e. everything a serialized message refers to. The
+     * combination is order independent, so equal catalogs agree whatever
+     * their load order.
+     *
+     * @param defaults Default-locale table, may be null.
+     * @return Fingerprint.
+     */
+    static std::uint64_t fingerprintOf(const Catalog::Table *defaults)
+    {
+        std::uint64_t sum = 0;
+        if (defaults)
+            defaults->forEach([&sum](std::string_view key, std::string_view value) { sum += fingerprintEntry(key, value); });
+        return sum;
+    }
+
+    /**
+     * @brief Contribution of one default-locale entry to the fingerprint.
+     *
+     * @details
+     * The fingerprint is a plain sum, so a composed generation can update
+     * its base's fingerprint entry by entry.
+     */
+    static std::uint64_t fingerprintEntry(std::string_view key, std::string_view value) noexcept
+    {
+        auto mix = [](std::uint64_t x)
+        {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            return x ^ (x >> 33);
+        };
+
+        std::uint64_t names = 0;
+        forEachPlaceholder(value, [&names, &mix](std::string_view name) { names += mix(hashKey(name)); });
+        return mix(hashKey(key) ^ (names * 0x9e3779b97f4a7c15ull));
+    }
+
+    /**
+     * @brief Returns the current catalog, kept alive after the lock is released.
+     * @return Catalog or nullptr.
+     */
+    static std::shared_ptr<const Catalog> pinCatalog()
+    {
+        LOC_READ_LOCK
+        return catalog;
+    }
+
+    /**
+     * @struct RealtimeView
+     * @brief Catalog plus the locale tables selected at publication time.
+     */
+    struct RealtimeView
+    {
+        std::shared_ptr<const Catalog> catalog; ///< Keeps the catalog alive.
+        const Catalog::Table *current = nullptr;  ///< Table of the current locale.
+        const Catalog::Table *fallback = nullptr; ///< Table of the default locale.
+    };
+
+    inline static std::uint64_t generationCounter = 0;             ///< Last committed generation.
+    inline static std::shared_ptr<const Catalog> catalog;          ///< Current immutable catalog.
+    inline static std::shared_ptr<const Catalog> baseCatalog;      ///< Loaded files without overlays.
+
+    /**
+     * @struct Overlay
+     * @brief Named patch layer stacked above the loaded files.
+     */
+    struct Overlay
+    {
+        std::string name; ///< Layer name.
+        ParsedFile data;  ///< Layer entries.
+    };
+    inline static std::list<Overlay> overlays; ///< Patch layers, lowest precedence first (never move-assigned).
+    inline static PreencodedNamespaces preencoded; ///< Namespaces encoded eagerly on commit.
+    inline static std::unique_ptr<const RealtimeView> realtimeOwner; ///< Owns the published view.
+    inline static std::atomic<const RealtimeView *> realtimeView{nullptr}; ///< View read by realtime callers.
+    inline static std::atomic<unsigned> realtimeEpoch{0};            ///< Grace-period epoch.
+    inline static std::atomic<unsigned> realtimeReaders[2]{};        ///< Realtime readers per epoch parity.
+
+    // --- Locale negotiation ----------------------------------------------------------
+
+    /**
+     * @struct LanguageRange
+     * @brief One entry of an `Accept-Language` header, pointing into the header text.
+     */
+    struct LanguageRange
+    {
+        std::string_view tag; ///< Language range, e.g. "fr-CH" or "*".
+        unsigned quality;     ///< q-value in thousandths (1..1000).
+    };
+
+    /**
+     * @struct NegotiationCache
+     * @brief Bounded, direct-mapped cache of `Accept-Language` header → negotiated locale.
+     *
+     * @details
+     * Entries are tagged with the catalog generation and the locale alias
+     * count they were resolved against, so a reload, an overlay change or a
+     * new alias invalidates them without a sweep.
+     * Slots are striped over a few locks; a colliding header simply evicts
+     * the previous occupant.
+     */
+    struct NegotiationCache
+    {
+        static constexpr std::size_t STRIPES = 16;    ///< Number of slot locks.
+        static constexpr std::size_t MAX_HEADER = 256; ///< Longer headers are not cached.
+
+        struct Slot
+        {
+            std::uint64_t hash;       ///< hashKey() of the header.
+            std::uint64_t generation; ///< Catalog generation, 0 for an empty slot.
+            std::uint64_t aliases;    ///< LocaleRegistry::aliases at resolution time.
+            std::string header;       ///< Header text.
+            std::string locale;       ///< Negotiated locale.
+
+            Slot() : hash(0), generation(0), aliases(0) {}
+        };
+
+#if LOC_THREAD_SAFE
+        std::array<std::shared_mutex, STRIPES> locks;          ///< Slot i is guarded by locks[i % STRIPES].
+#endif
+        std::array<Slot, LOC_NEGOTIATION_CACHE_SIZE> slots;    ///< Cached resolutions.
+    };
+    inline static NegotiationCache negotiationCache; ///< Header → locale cache.
+
+    /**
+     * @brief Compares two language tags case-insensitively, treating '-' and '_' alike.
+     */
+    static bool languageTagEquals(std::string_view a, std::string_view b) noexcept
+    {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            char x = a[i] == '_' ? '-' : static_cast<char>(std::tolower(static_cast<unsigned char>(a[i])));
+            char y = b[i] == '_' ? '-' : static_cast<char>(std::tolower(static_cast<unsigned char>(b[i])));
+            if (x != y)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses a q-value ("0", "0.8", "1.000", ...) into thousandths.
+     * @return Quality, or std::nullopt when the value is malformed.
+     */
+    static std::optional<unsigned> parseQuality(std::string_view text) noexcept
+    {
+        if (text.empty() || (text[0] != '0' && text[0] != '1'))
+            return std::nullopt;
+        unsigned whole = static_cast<unsigned>(text[0] - '0');
+        unsigned fraction = 0;
+        std::size_t digits = 0;
+        if (text.size() > 1)
+        {
+            if (text[1] != '.' || text.size() > 5)
+                return std::nullopt;
+            for (std::size_t i = 2; i < text.size(); ++i, ++digits)
+            {
+                if (text[i] < '0' || text[i] > '9')
+                    return std::nullopt;
+                fraction = fraction * 10 + static_cast<unsigned>(text[i] - '0');
+            }
+        }
+        for (; digits < 3; ++digits)
+            fraction *= 10;
+        if (whole == 1 && fraction != 0)
+            return std::nullopt;
+        return whole * 1000 + fraction;
+    }
+
+    /**
+     * @brief Splits an `Accept-Language` header into ranges ordered by preference.
+     *
+     * @details
+     * Works in place on the header text. Malformed ranges and ranges with
+     * q=0 are dropped; equal q-values keep header order. When the header has
+     * more than @p capacity ranges, the least preferred ones are discarded.
+     *
+     * @param header Header value.
+     * @param out Output array.
+     * @param capacity Size of @p out.
+     * @return Number of ranges written.
+     */
+    static std::size_t parseAcceptLanguage(std::string_view header, LanguageRange *out, std::size_t capacity) noexcept
+    {
+        auto trim = [](std::string_view text)
+        {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+                text.remove_prefix(1);
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+                text.remove_suffix(1);
+            return text;
+        };
+
+        std::size_t count = 0;
+        while (!header.empty())
+        {
+            std::size_t comma = header.find(',');
+            std::string_view item = header.substr(0, comma);
+            header.remove_prefix(comma == std::string_view::npos ? header.size() : comma + 1);
+
+            std::size_t semicolon = item.find(';');
+            std::string_view tag = trim(item.substr(0, semicolon));
+            if (tag.empty() || tag.size() > 64)
+                continue;
+            bool valid = tag == "*";
+            if (!valid)
+            {
+                valid = std::isalpha(static_cast<unsigned char>(tag.front())) != 0;
+                for (char c : tag)
+                    valid = valid && (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_');
+            }
+
+            std::optional<unsigned> quality = 1000;
+            while (valid && semicolon != std::string_view::npos)
+            {
+                item.remove_prefix(semicolon + 1);
+                semicolon = item.find(';');
+                std::string_view param = trim(item.substr(0, semicolon));
+                if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=')
+                    quality = parseQuality(param.substr(2));
+            }
+            if (!valid || !quality || *quality == 0)
+                continue;
+
+            std::size_t pos = count;
+            if (count < capacity)
+                ++count;
+            else if (out[capacity - 1].quality < *quality)
+                pos = capacity - 1;
+            else
+                continue;
+            for (; pos > 0 && out[pos - 1].quality < *quality; --pos)
+                out[pos] = out[pos - 1];
+            out[pos] = {tag, *quality};
+        }
+        return count;
+    }
+
+    /**
+     * @brief Finds a loaded locale matching a language tag.
+     * @details Goes through findLocaleId(), so legacy tags ("iw") and
+     * registered aliases resolve like everywhere else.
+     * @return Canonical locale name, or an empty view.
+     */
+    static std::string_view findLocaleTag(const Catalog &source, std::string_view tag)
+    {
+        std::optional<LocaleId> id = findLocaleId(tag);
+        return id && source.table(*id) ? localeName(*id) : std::string_view();
+    }
+
+    /**
+     * @brief Resolves an `Accept-Language` header against the loaded locales.
+     *
+     * @details
+     * Ranges are tried in preference order. Each range walks its BCP-47
+     * truncation chain ("zh-Hant-TW" → "zh-Hant" → "zh", dropping a dangling
+     * single-letter subtag), then falls back to any loaded locale sharing its
+     * primary language ("fr-CH" → "fr-FR"). "*" selects the default locale.
+     * Caller must hold at least a read lock.
+     *
+     * @param header Header value.
+     * @return Locale name, valid while the lock is held.
+     */
+    static std::string_view negotiateUnlocked(std::string_view header)
+    {
+        std::array<LanguageRange, LOC_ACCEPT_LANGUAGE_MAX_RANGES> ranges;
+        std::size_t count = parseAcceptLanguage(header, ranges.data(), ranges.size());
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string_view tag = ranges[i].tag;
+            if (tag == "*")
+                return localeName(DEFAULT_LOCALE_ID);
+
+            for (std::string_view prefix = tag; !prefix.empty();)
+            {
+                if (std::string_view match = findLocaleTag(*catalog, prefix); !match.empty())
+                    return match;
+                std::size_t cut = prefix.find_last_of("-_");
+                if (cut == std::string_view::npos)
+                    break;
+                prefix = prefix.substr(0, cut);
+                if (prefix.size() >= 2 && (prefix[prefix.size() - 2] == '-' || prefix[prefix.size() - 2] == '_'))
+                    prefix.remove_suffix(2);
+            }
+
+            std::string primary = canonicalLocale(tag.substr(0, tag.find_first_of("-_")));
+            for (std::string_view locale : catalog->locales)
+                if (languageTagEquals(locale.substr(0, locale.find_first_of("-_")), primary))
+                    return locale;
+        }
+        return localeName(DEFAULT_LOCALE_ID);
+    }
+
+    /**
+     * @brief Builds the next catalog generation. Caller must hold the write lock.
+     * @param base Previous generation to start from, or nullptr for an empty catalog.
+     * @param parsed Files overriding entries of `base`, applied in order.
+     * @return New catalog tagged with the next generation number.
+     */
+    static std::shared_ptr<const Catalog> buildCatalog(const Catalog *base, const std::vector<ParsedFile> &parsed)
+    {
+        // Resolve the merged view first so the arena can be sized exactly.
+        std::pmr::monotonic_buffer_resource scratch(upstreamResource());
+        std::pmr::vector<LocaleId> order(&scratch);
+        std::pmr::unordered_map<LocaleId, SourceMap> merged(&scratch);
+        std::pmr::unordered_map<LocaleId, TypedSource> typedMerged(&scratch);
+        std::pmr::unordered_map<LocaleId, TypedSource> variantsMerged(&scratch);
+
+        auto localeTable = [&](LocaleId locale) -> SourceMap &
+        {
+            auto it = merged.find(locale);
+            if (it == merged.end())
+            {
+                order.push_back(locale);
+                it = merged.emplace(locale, SourceMap(&scratch)).first;
+            }
+            return it->second;
+        };
+
+        if (base)
+        {
+            for (std::size_t i = 0; i < base->localeIds.size(); ++i)
+            {
+                auto &table = localeTable(base->localeIds[i]);
+                table.reserve(base->storage[i].size());
+                base->storage[i].forEach([&table](std::string_view key, std::string_view value)
+                                        { table.emplace(key, value); });
+                for (auto [sides, target] : {std::pair(&base->typed, &typedMerged), std::pair(&base->variants, &variantsMerged)})
+                {
+                    if ((*sides)[i].empty())
+                        continue;
+                    auto &values = target->try_emplace(base->localeIds[i]).first->second;
+                    for (const auto &[key, value] : (*sides)[i])
+                        values.emplace(key, &value);
+                }
+            }
+        }
+        auto erase = [](std::pmr::unordered_map<LocaleId, TypedSource> &from, LocaleId id, std::string_view key)
+        {
+            if (auto values = from.find(id); values != from.end())
+                values->second.erase(key);
+        };
+        for (const auto &file : parsed)
+        {
+            // A key keeps the kind it was given last: a string replaces a typed leaf and vice versa.
+            // A variant set is a string (its first variant) plus an entry in `variantsMerged`.
+            for (const auto &[lang, entries] : file.locales)
+            {
+                LocaleId id = internLocale(lang);
+                auto &table = localeTable(id);
+                for (const auto &[key, value] : entries)
+                {
+                    table.insert_or_assign(std::string_view(key), std::string_view(value));
+                    erase(typedMerged, id, key);
+                    erase(variantsMerged, id, key);
+                }
+            }
+            for (const auto &[lang, entries] : file.typed)
+            {
+                LocaleId id = internLocale(lang);
+                auto &table = localeTable(id);
+                auto &values = typedMerged.try_emplace(id).first->second;
+                for (const auto &[key, value] : entries)
+                {
+                    table.erase(std::string_view(key));
+                    erase(variantsMerged, id, key);
+                    values.insert_or_assign(std::string_view(key), &value);
+                }
+            }
+            for (const auto &[lang, entries] : file.variants)
+            {
+                auto &values = variantsMerged.try_emplace(internLocale(lang)).first->second;
+                for (const auto &[key, value] : entries)
+                    values.insert_or_assign(std::string_view(key), &value);
+            }
+        }
+
+        // Mapped catalogs carry over by reference; a re-parsed file replaces its previous mapping.
+        std::vector<std::shared_ptr<const MoFile>> moFiles;
+        auto addMo = [&](const std::shared_ptr<const MoFile> &mo, const std::string &path)
+        {
+            moFiles.erase(std::remove_if(moFiles.begin(), moFiles.end(),
+                                         [&path](const auto &known) { return known->path == path; }),
+                          moFiles.end());
+            moFiles.push_back(mo);
+            localeTable(internLocale(mo->locale));
+        };
+        if (base)
+            for (const auto &mo : base->moFiles)
+                addMo(mo, mo->path);
+        for (const auto &file : parsed)
+            if (file.mo)
+                addMo(file.mo, file.mo->path);
+
+        std::size_t bytes = order.size() * (2 * sizeof(std::string_view) + sizeof(Storage) + sizeof(Catalog::Table) +
+                                            2 * sizeof(TypedTable) + 2 * sizeof(LocaleId) + alignof(std::max_align_t));
+        for (const auto &[lang, table] : merged)
+            bytes += sizeof(std::uint16_t) * (std::size_t(lang) + 1) + Storage::bytesFor(table);
+        for (const auto &[lang, values] : typedMerged)
+            bytes += typedBytesFor(values);
+        for (const auto &[lang, sets] : variantsMerged)
+            bytes += typedBytesFor(sets);
+
+        std::pmr::memory_resource *upstream = upstreamResource();
+        auto next = std::allocate_shared<Catalog>(std::pmr::polymorphic_allocator<Catalog>(upstream), upstream, bytes);
+        next->generation = ++generationCounter;
+        next->locales.reserve(order.size());
+        next->localeIds.reserve(order.size());
+        next->storage.reserve(order.size());
+        next->typed.reserve(order.size());
+        next->variants.reserve(order.size());
+        for (LocaleId lang : order)
+        {
+            next->addLocale(lang, merged.at(lang));
+            auto values = typedMerged.find(lang);
+            buildTypedTable(next->typed.emplace_back(), next->arena,
+                            values == typedMerged.end() ? nullptr : &values->second);
+            auto sets = variantsMerged.find(lang);
+            buildTypedTable(next->variants.emplace_back(), next->arena,
+                            sets == variantsMerged.end() ? nullptr : &sets->second);
+        }
+
+        if (!moFiles.empty())
+        {
+            next->moFiles.assign(moFiles.begin(), moFiles.end());
+            next->external.reserve(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                next->external.emplace_back();
+            for (const auto &mo : next->moFiles)
+            {
+                LocaleId id = internLocale(mo->locale);
+                for (std::size_t i = 0; i < order.size(); ++i)
+                    if (next->localeIds[i] == id)
+                        next->external[i].push_back(mo.get());
+            }
+            for (std::size_t i = 0; i < order.size(); ++i)
+                if (!next->external[i].empty())
+                    next->storage[i].external = &next->external[i];
+        }
+        next->linkTables();
+        next->fingerprint = fingerprintOf(next->table(DEFAULT_LOCALE_ID));
+        return next;
+    }
+
+    /**
+     * @brief Composes the overlay layers above a base generation. Caller must hold the write lock.
+     *
+     * @details
+     * The result owns only the merged overlay tables and references the
+     * base tables, so the cost is proportional to the overlays, not to the
+     * base catalog. Without overlays the base generation is returned as is.
+     *
+     * @param base Generation built from the loaded files, may be null.
+     * @return Generation to publish.
+     */
+    static std::shared_ptr<const Catalog> composeOverlays(const std::shared_ptr<const Catalog> &base)
+    {
+        if (overlays.empty())
+            return base;
+
+        std::pmr::monotonic_buffer_resource scratch(upstreamResource());
+        std::pmr::vector<LocaleId> order(&scratch);
+        std::pmr::unordered_map<LocaleId, SourceMap> merged(&scratch);
+        std::pmr::unordered_map<LocaleId, TypedSource> typedMerged(&scratch);
+        std::pmr::unordered_map<LocaleId, TypedSource> variantsMerged(&scratch);
+        if (base)
+            order.assign(base->localeIds.begin(), base->localeIds.end());
+        auto addToOrder = [&order](LocaleId lang)
+        {
+            if (std::find(order.begin(), order.end(), lang) == order.end())
+                order.push_back(lang);
+        };
+        auto erase = [](std::pmr::unordered_map<LocaleId, TypedSource> &from, LocaleId id, std::string_view key)
+        {
+            if (auto values = from.find(id); values != from.end())
+                values->second.erase(key);
+        };
+        for (const Overlay &layer : overlays)
+        {
+            for (const auto &[name, entries] : layer.data.locales)
+            {
+                LocaleId lang = internLocale(name);
+                auto it = merged.find(lang);
+                if (it == merged.end())
+                {
+                    it = merged.emplace(lang, SourceMap(&scratch)).first;
+                    addToOrder(lang);
+                }
+                for (const auto &[key, value] : entries)
+                {
+                    it->second.insert_or_assign(std::string_view(key), std::string_view(value));
+                    erase(typedMerged, lang, key);
+                    erase(variantsMerged, lang, key);
+                }
+            }
+            for (const auto &[name, entries] : layer.data.typed)
+            {
+                LocaleId lang = internLocale(name);
+                addToOrder(lang);
+                // Typed keys need an overlay table even without strings: it carries their tombstones.
+                auto &strings = merged.try_emplace(lang, SourceMap(&scratch)).first->second;
+                auto &values = typedMerged.try_emplace(lang).first->second;
+                for (const auto &[key, value] : entries)
+                {
+                    strings.erase(std::string_view(key));
+                    erase(variantsMerged, lang, key);
+                    values.insert_or_assign(std::string_view(key), &value);
+                }
+            }
+            for (const auto &[name, entries] : layer.data.variants)
+            {
+                auto &values = variantsMerged.try_emplace(internLocale(name)).first->second;
+                for (const auto &[key, value] : entries)
+                    values.insert_or_assign(std::string_view(key), &value);
+            }
+        }
+
+        std::size_t bytes = order.size() * (2 * sizeof(std::string_view) + sizeof(Storage) + sizeof(Catalog::Table) +
+                                            2 * sizeof(TypedTable) + 2 * sizeof(LocaleId) + alignof(std::max_align_t));
+        for (const auto &[lang, table] : merged)
+        {
+            auto values = typedMerged.find(lang);
+            std::size_t filtered = table.size() + (values == typedMerged.end() ? 0 : values->second.size());
+            bytes += sizeof(std::uint16_t) * (std::size_t(lang) + 1) + Storage::bytesFor(table) + filtered * 4 + 64;
+        }
+        for (const auto &[lang, values] : typedMerged)
+            bytes += typedBytesFor(values);
+        for (const auto &[lang, sets] : variantsMerged)
+            bytes += typedBytesFor(sets);
+
+        std::pmr::memory_resource *upstream = upstreamResource();
+        auto next = std::allocate_shared<Catalog>(std::pmr::polymorphic_allocator<Catalog>(upstream), upstream, bytes);
+        next->generation = ++generationCounter;
+        next->shared = base;
+        next->fingerprint = base ? base->fingerprint : 0;
+        next->locales.reserve(order.size());
+        next->localeIds.reserve(order.size());
+        next->storage.reserve(merged.size());
+        next->tables.reserve(order.size());
+        next->typed.reserve(order.size());
+        next->variants.reserve(order.size());
+
+        // The fingerprint only covers the default locale's own entries (see
+        // fingerprintOf()), so mapped .mo entries are not subtracted.
+        const Catalog::Table *baseLayer = base ? base->table(DEFAULT_LOCALE_ID) : nullptr;
+        const Storage *baseDefaults = baseLayer ? baseLayer->baseTable() : nullptr;
+        for (LocaleId lang : order)
+        {
+            const Catalog::Table *under = base ? base->table(lang) : nullptr;
+            const Storage *baseTable = under ? under->baseTable() : nullptr;
+            next->addLocaleName(lang);
+            auto values = typedMerged.find(lang);
+            buildTypedTable(next->typed.emplace_back(), next->arena,
+                            values == typedMerged.end() ? nullptr : &values->second);
+            auto sets = variantsMerged.find(lang);
+            buildTypedTable(next->variants.emplace_back(), next->arena,
+                            sets == variantsMerged.end() ? nullptr : &sets->second);
+            auto it = merged.find(lang);
+            if (it == merged.end())
+            {
+                next->tables.emplace_back(baseTable);
+                continue;
+            }
+
+            Storage &overlay = next->storage.emplace_back();
+            overlay.build(next->arena, it->second);
+            const TypedTable &shadow = next->typed.back();
+            next->tables.emplace_back(baseTable, &overlay, shadow.empty() ? nullptr : &shadow, next->arena);
+
+            if (lang == DEFAULT_LOCALE_ID)
+            {
+                auto drop = [&](std::string_view key)
+                {
+                    if (baseDefaults)
+                        if (auto old = baseDefaults->findOwn(key, hashKey(key)))
+                            next->fingerprint -= fingerprintEntry(key, *old);
+                };
+                for (const auto &[key, value] : it->second)
+                {
+                    drop(key);
+                    next->fingerprint += fingerprintEntry(key, value);
+                }
+                for (const auto &[key, value] : shadow)
+                    drop(key);
+            }
+        }
+        next->indexLocales();
+        return next;
+    }
+
+    /**
+     * @brief Waits until no realtime reader can still observe a previously published view.
+     * Caller must hold the write lock.
+     */
+    static void waitForRealtimeReaders()
+    {
+        unsigned epoch = realtimeEpoch.load();
+        while (realtimeReaders[(epoch + 1) & 1u].load() != 0)
+            std::this_thread::yield();
+        realtimeEpoch.store(epoch + 1);
+        while (realtimeReaders[epoch & 1u].load() != 0)
+            std::this_thread::yield();
+    }
+
+    /**
+     * @brief Publishes a new realtime view for the current catalog and locale.
+     * Caller must hold the write lock.
+     */
+    static void publishRealtimeView()
+    {
+        auto view = std::make_unique<RealtimeView>();
+        view->catalog = catalog;
+        if (catalog)
+        {
+            view->current = catalog->table(currentLocaleId);
+            view->fallback = catalog->table(DEFAULT_LOCALE_ID);
+        }
+
+        realtimeView.store(view.get());
+        waitForRealtimeReaders();
+        realtimeOwner = std::move(view);
+    }
+
+    // --- Signal-safe prerendered messages -----------------------------------------
+
+    /**
+     * @struct SignalSafeTable
+     * @brief Fixed-size prerendered copy of the registered keys for the current locale.
+     *
+     * @details
+     * Plain static storage, no allocation and no destructors: readable from a
+     * signal handler. Two tables are kept; the writer fills the inactive one
+     * and then flips `signalActive`.
+     */
+    struct SignalSafeTable
+    {
+        std::size_t count;                                                  ///< Number of used slots.
+        std::size_t lengths[LOC_SIGNAL_SAFE_SLOTS];                         ///< Value lengths in bytes.
+        char keys[LOC_SIGNAL_SAFE_SLOTS][LOC_SIGNAL_SAFE_KEY_SIZE];         ///< NUL-terminated keys.
+        char values[LOC_SIGNAL_SAFE_SLOTS][LOC_SIGNAL_SAFE_VALUE_SIZE];     ///< Prerendered values.
+    };
+
+    static_assert(std::atomic<unsigned>::is_always_lock_free,
+                  "Signal-safe table requires lock-free atomics");
+
+    inline static SignalSafeTable signalTables[2];       ///< Double-buffered tables.
+    inline static std::atomic<unsigned> signalActive{0}; ///< Index of the published table.
+    inline static std::atomic<unsigned> signalReaders[2]{}; ///< Readers currently inside each table.
+    inline static std::vector<std::string> signalSafeKeys; ///< Registered keys, in slot order.
+
+    /**
+     * @brief Pins the published signal-safe table. Async-signal-safe.
+     * @return Index of the pinned table; release it with leaveSignalTable().
+     */
+    static unsigned enterSignalTable() noexcept
+    {
+        unsigned idx = signalActive.load();
+        for (;;)
+        {
+            signalReaders[idx].fetch_add(1);
+            unsigned again = signalActive.load();
+            if (again == idx)
+                return idx;
+            signalReaders[idx].fetch_sub(1);
+            idx = again;
+        }
+    }
+
+    /**
+     * @brief Releases a table pinned by enterSignalTable().
+     * @param idx Table index.
+     */
+    static void leaveSignalTable(unsigned idx) noexcept
+    {
+        signalReaders[idx].fetch_sub(1);
+    }
+
+    /**
+     * @brief Finds a value in the given locale without inserting.
+     * @param locale Language code or LocaleId.
+     * @param key Translation key.
+     * @return View of the value, or std::nullopt. Caller must hold a lock.
+     */
+    template <class Locale>
+    static std::optional<std::string_view> findValueUnlocked(const Locale &locale, std::string_view key)
+    {
+        const Catalog::Table *table = catalog ? catalog->table(locale) : nullptr;
+        if (!table)
+            return std::nullopt;
+        return table->find(key);
+    }
+
+    /**
+     * @brief Rebuilds the inactive signal-safe table and publishes it.
+     * Caller must hold the write lock.
+     */
+    static void refreshSignalSafeTable()
+    {
+        unsigned target = 1u - signalActive.load();
+        while (signalReaders[target].load() != 0)
+            std::this_thread::yield();
+
+        SignalSafeTable &table = signalTables[target];
+        table.count = signalSafeKeys.size();
+        for (std::size_t i = 0; i < table.count; ++i)
+        {
+            const std::string &key = signalSafeKeys[i];
+            std::memcpy(table.keys[i], key.c_str(), key.size() + 1);
+
+            std::optional<std::string_view> value = findValueUnlocked(currentLocaleId, key);
+            if (!value)
+                value = findValueUnlocked(DEFAULT_LOCALE_ID, key);
+
+            std::size_t len = value ? value->size() : 0;
+            if (len > LOC_SIGNAL_SAFE_VALUE_SIZE - 1)
+            {
+                len = LOC_SIGNAL_SAFE_VALUE_SIZE - 1;
+                while (len > 0 && (static_cast<unsigned char>((*value)[len]) & 0xC0) == 0x80)
+                    --len; // do not cut a UTF-8 sequence in half
+            }
+            if (len)
+                std::memcpy(table.values[i], value->data(), len);
+            table.values[i][len] = '\0';
+            table.lengths[i] = len;
+        }
+        signalActive.store(target);
+    }
+
+    // --- Pollable change notification ----------------------------------------------
+
+    /**
+     * @struct ChangeNotifier
+     * @brief Owns the descriptor signalled on every committed catalog generation.
+     *
+     * @details
+     * Uses an `eventfd` on Linux and a non-blocking pipe on other POSIX
+     * systems. Not available on Windows.
+     */
+    struct ChangeNotifier
+    {
+        std::mutex mtx;                          ///< Guards lazy creation.
+        std::atomic<int> readFd;                 ///< Descriptor handed to event loops.
+        int writeFd;                             ///< Descriptor written on commit (same as readFd for eventfd).
+        std::atomic<std::uint64_t> committed;    ///< Last committed generation.
+        std::atomic<std::uint64_t> consumed;     ///< Generation returned by the last consumeChanges().
+
+        ChangeNotifier() : readFd(-1), writeFd(-1), committed(0), consumed(0) {}
+        ~ChangeNotifier()
+        {
+#if !defined(_WIN32)
+            int fd = readFd.load();
+            if (fd >= 0)
+                ::close(fd);
+            if (writeFd >= 0 && writeFd != fd)
+                ::close(writeFd);
+#endif
+        }
+    };
+    inline static ChangeNotifier changeNotifier; ///< Generation commit notification state.
+
+    /**
+     * @brief Records a committed generation and makes the descriptor readable.
+     * Caller must hold the write lock. Never blocks.
+     * @param generation Committed generation number.
+     */
+    static void notifyGenerationCommitted(std::uint64_t generation) noexcept
+    {
+        changeNotifier.committed.store(generation, std::memory_order_release);
+#if !defined(_WIN32)
+        if (changeNotifier.readFd.load(std::memory_order_acquire) < 0)
+            return;
+#if defined(__linux__)
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(changeNotifier.writeFd, &one, sizeof(one));
+#else
+        char byte = 1;
+        [[maybe_unused]] auto n = ::write(changeNotifier.writeFd, &byte, 1);
+#endif
+#endif
+    }
+
+    /**
+     * @brief Rebuilds every derived read-only view after a catalog or locale change.
+     * Caller must hold the write lock.
+     * @param catalogChanged false if only the locale changed.
+     */
+    static void publishSnapshots(bool catalogChanged = true)
+    {
+        if (catalogChanged)
+            preencodeUnlocked();
+        publishRealtimeView();
+        refreshSignalSafeTable();
+        if (catalogChanged && catalog)
+            notifyGenerationCommitted(catalog->generation);
+    }
+
+    /**
+     * @brief Builds the eager UTF-16/UTF-32 copies of the current generation.
+     * Caller must hold the write lock.
+     *
+     * @details
+     * A generation composed with overlays encodes only its overlay tables;
+     * the base values are encoded once into the shared generation, whose
+     * copies encoded() finds for every later composition.
+     *
+     * @param all Re-encode the shared generation too (the namespaces changed).
+     */
+    static void preencodeUnlocked(bool all = false)
+    {
+        if (!catalog || preencoded.prefixes.empty())
+            return;
+        auto encode = [](const Catalog &target, const auto &table)
+        {
+            table.forEach([&target](std::string_view key, std::string_view value)
+                          {
+                              for (const std::string &prefix : preencoded.prefixes)
+                              {
+                                  if (key.substr(0, prefix.size()) != prefix)
+                                      continue;
+                                  if (preencoded.utf16)
+                                      (void)target.encoded<char16_t>(value);
+                                  if (preencoded.utf32)
+                                      (void)target.encoded<char32_t>(value);
+                                  break;
+                              }
+                          });
+        };
+
+        const Catalog *base = catalog->shared.get();
+        if (!base)
+        {
+            if (catalog->wide.preencoded && !all)
+                return; // republished after the last overlay was removed
+            for (const Catalog::Table &table : catalog->tables)
+                encode(*catalog, table);
+            catalog->wide.preencoded = true;
+            return;
+        }
+        if (all || !base->wide.preencoded)
+        {
+            for (const Catalog::Table &table : base->tables)
+                encode(*base, table);
+            base->wide.preencoded = true;
+        }
+        for (const Catalog::Table &table : catalog->tables)
+            if (const Storage *overlay = table.overlayTable())
+                encode(*catalog, *overlay);
+    }
+
+    /**
+     * @brief Resolves a key to its encoded copy in the current locale, with default fallback.
+     * @tparam Char `char16_t` or `char32_t`.
+     * @param key Translation key.
+     * @return Handle to the encoded value or to an encoded `[Missing:key]` marker.
+     */
+    template <class Char>
+    static LocWideString<Char> translateWide(std::string_view key)
+    {
+        LOC_READ_LOCK
+        if (catalog)
+        {
+            std::uint64_t hash = hashKey(key);
+            for (const Catalog::Table *table : {catalog->table(currentLocaleId), catalog->table(DEFAULT_LOCALE_ID)})
+            {
+                if (!table)
+                    continue;
+                if (auto value = table->find(key, hash))
+                {
+                    std::basic_string_view<Char> text = catalog->encoded<Char>(*value);
+                    return LocWideString<Char>(std::shared_ptr<const Char>(catalog, text.data()), text.size(), true);
+                }
+            }
+        }
+
+        std::string marker = "[Missing:";
+        marker.append(key).append("]");
+        auto missing = std::make_shared<std::basic_string<Char>>(encodeUtf8As<Char>(marker, nullptr), Char());
+        encodeUtf8As<Char>(marker, missing->data());
+        std::size_t length = missing->size();
+        return LocWideString<Char>(std::shared_ptr<const Char>(missing, missing->data()), length, false);
+    }
+
+    /**
+     * @brief Merges parsed files and commits a new catalog generation.
+     * Caller must hold the write lock.
+     * @param parsed Files parsed outside the lock.
+     * @param clearBefore If true, starts from an empty catalog.
+     * @return Committed generation number.
+     */
+    static std::uint64_t commitParsedUnlocked(const std::vector<ParsedFile> &parsed, bool clearBefore)
+    {
+        for (const auto &file : parsed)
+        {
+            std::filesystem::path p(file.path);
+            fileTimestamps[file.path] = file.timestamp;
+            if (std::find(jsons.begin(), jsons.end(), p) == jsons.end())
+                jsons.push_back(p);
+        }
+
+        baseCatalog = buildCatalog(clearBefore ? nullptr : baseCatalog.get(), parsed);
+        catalog = composeOverlays(baseCatalog);
+        publishSnapshots();
+        for (const auto &file : parsed)
+            fileGenerations[file.path] = catalog->generation;
+        refreshMetadataUnlocked(parsed, clearBefore);
+        return catalog->generation;
+    }
+
+    /**
+     * @brief Replaces the metadata of one file in a metadata table.
+     * @param entries Table to update.
+     * @param path Source file.
+     * @param list Metadata collected from it.
+     * @param generation Generation that loaded the file.
+     */
+    static void storeMetadata(std::unordered_map<KeyId, KeyMetadata> &entries, const std::string &path,
+                              const MetadataList &list, std::uint64_t generation)
+    {
+        for (auto it = entries.begin(); it != entries.end();)
+            it = it->second.file == path ? entries.erase(it) : std::next(it);
+
+        for (const auto &[key, meta] : list)
+        {
+            KeyMetadata &stored = entries[internKey(key)];
+            stored = meta;
+            stored.generation = generation;
+        }
+    }
+
+    /**
+     * @brief Fills the cold table from every loaded JSON file.
+     *
+     * @details
+     * The file list is copied under the catalog lock; the files are read and
+     * parsed without any lock held, and the finished table is swapped in
+     * under `metadataTable.mtx` unless a commit happened in between, in which
+     * case the caller sees `loaded` still false and retries.
+     */
+    static void loadMetadata()
+    {
+        std::vector<std::pair<std::filesystem::path, std::uint64_t>> files;
+        std::uint64_t epoch;
+        {
+            LOC_READ_LOCK
+#if LOC_THREAD_SAFE
+            std::lock_guard<std::mutex> guard(metadataTable.mtx);
+#endif
+            if (metadataTable.loaded)
+                return;
+            epoch = metadataTable.epoch;
+            for (const auto &p : jsons)
+            {
+                auto generation = fileGenerations.find(p.string());
+                files.emplace_back(p, generation == fileGenerations.end() ? 0 : generation->second);
+            }
+        }
+
+        std::unordered_map<KeyId, KeyMetadata> entries;
+        for (const auto &[p, generation] : files)
+        {
+            auto extension = p.extension();
+            if (extension == ".mo" || extension == ".csv" || extension == ".tsv")
+                continue;
+            try
+            {
+                std::ifstream file(p);
+                std::string text(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>{});
+                MetadataList list;
+                collectMetadata(p.string(), p.stem().string(), text, nlohmann::json::parse(text), list);
+                storeMetadata(entries, p.string(), list, generation);
+            }
+            catch (const std::exception &ex)
+            {
+                LOC_RAISE_ERROR("[!] Failed to read metadata of " + p.string() + ": " + ex.what(), 1);
+            }
+        }
+
+#if LOC_THREAD_SAFE
+        std::lock_guard<std::mutex> guard(metadataTable.mtx);
+#endif
+        if (metadataTable.loaded || metadataTable.epoch != epoch)
+            return;
+        metadataTable.entries.swap(entries);
+        metadataTable.loaded = true;
+    }
+
+    /**
+     * @brief Looks a key up in the cold table, filling it first if needed.
+     * @param id Returns the key id, or std::nullopt; called with `metadataTable.mtx` held.
+     * @return Copy of the metadata, or std::nullopt.
+     */
+    template <class KeyIdOf>
+    static std::optional<KeyMetadata> findMetadata(KeyIdOf id)
+    {
+        for (;;)
+        {
+            {
+#if LOC_THREAD_SAFE
+                std::lock_guard<std::mutex> guard(metadataTable.mtx);
+#endif
+                if (metadataTable.loaded)
+                {
+                    std::optional<KeyId> key = id();
+                    auto it = key ? metadataTable.entries.find(*key) : metadataTable.entries.end();
+                    if (it == metadataTable.entries.end())
+                        return std::nullopt;
+                    return it->second;
+                }
+            }
+            loadMetadata();
+        }
+    }
+
+    /**
+     * @brief Brings the cold table up to date after a commit.
+     * Caller must hold the write lock.
+     * @param parsed Files just committed.
+     * @param clearBefore Whether the commit started from an empty catalog.
+     */
+    static void refreshMetadataUnlocked(const std::vector<ParsedFile> &parsed, bool clearBefore)
+    {
+#if LOC_THREAD_SAFE
+        std::lock_guard<std::mutex> guard(metadataTable.mtx);
+#endif
+        ++metadataTable.epoch;
+        if (!metadataTable.loaded)
+            return;
+        bool collected = std::all_of(parsed.begin(), parsed.end(), [](const ParsedFile &file)
+                                     { return file.metaCollected; });
+        if (!collected)
+        {
+            // Not collected while parsing: re-read on the next request.
+            metadataTable.loaded = false;
+            metadataTable.entries.clear();
+            return;
+        }
+        if (clearBefore)
+            metadataTable.entries.clear();
+        for (const auto &file : parsed)
+            storeMetadata(metadataTable.entries, file.path, file.meta, fileGenerations[file.path]);
+    }
+
+    /**
+     * @brief Merges parsed files and commits a new catalog generation.
+     * @param parsed Files parsed outside the lock.
+     * @param clearBefore If true, starts from an empty catalog.
+     * @return Committed generation number.
+     */
+    static std::uint64_t commitParsed(std::vector<ParsedFile> &&parsed, bool clearBefore = false)
+    {
+        LOC_WRITE_LOCK
+        return commitParsedUnlocked(parsed, clearBefore);
+    }
+
+    /**
+     * @brief Inserts or replaces an overlay and publishes the recomposed generation.
+     * Caller must hold the write lock.
+     * @param name Layer name.
+     * @param parsed Layer entries.
+     */
+    static void commitOverlayUnlocked(const std::string &name, ParsedFile &&parsed)
+    {
+        auto it = std::find_if(overlays.begin(), overlays.end(), [&name](const Overlay &o) { return o.name == name; });
+        overlays.insert(it, Overlay{name, std::move(parsed)});
+        if (it != overlays.end())
+            overlays.erase(it);
+        catalog = composeOverlays(baseCatalog);
+        publishSnapshots();
+    }
+
+    /// Variant requested from a variant set: an index, or a bucketing hash reduced modulo the set size.
+    struct VariantPick
+    {
+        std::uint64_t value; ///< Index or bucketing hash.
+        bool bucketed;       ///< Whether `value` is a hash.
+    };
+
+    /**
+     * @brief Picks one variant of a set.
+     * @param set Non-empty array of strings.
+     * @param pick Requested variant; an out-of-range index selects the first one.
+     * @return Variant text.
+     */
+    static std::string_view selectVariant(const LocValue &set, const VariantPick &pick) noexcept
+    {
+        std::uint64_t index = pick.bucketed ? pick.value % set.size() : pick.value < set.size() ? pick.value : 0;
+        return *set[static_cast<std::size_t>(index)].asString();
+    }
+
+    /**
+     * @brief Translates a key into the requested string type.
+     * @tparam String `std::string` or `std::pmr::string`.
+     * @param key Translation key.
+     * @param alloc Allocator for the result.
+     * @return Localized string or missing-key placeholder.
+     */
+    template <class String>
+    static String translateAs(std::string_view key, const typename String::allocator_type &alloc,
+                              const VariantPick *pick = nullptr)
+    {
+        LOC_READ_LOCK
+        const auto &dbg = debugOptions;
+        String result(alloc);
+        if (dbg.enabled)
+        {
+            result += dbg.prefix;
+            if (dbg.coloredOutput)
+                result.append(dbg.keyColor).append("[").append(key).append("]").append(dbg.resetColor).append(" ");
+            else
+                result.append("[").append(key).append("] ");
+        }
+
+        std::optional<std::string_view> value;
+        if (pick && catalog)
+            if (const LocValue *set = catalog->resolveVariants(currentLocaleId, key))
+                value = selectVariant(*set, *pick);
+        if (!value)
+            value = findValueUnlocked(currentLocaleId, key);
+        if (!value)
+            value = findValueUnlocked(DEFAULT_LOCALE_ID, key);
+        if (value)
+            return result.append(*value);
+
+        result.assign("[Missing:").append(key).append("]");
+        if (dbg.enabled && dbg.coloredOutput)
+            result.insert(0, dbg.keyColor).append(dbg.resetColor);
+        return result;
+    }
+
+    /**
+     * @brief Resolves a key in a locale, falling back to the default locale.
+     * Caller must hold a lock.
+     * @param locale Language code or LocaleId.
+     * @param key Translation key.
+     * @return Handle to the value, or to a `[Missing:key]` marker.
+     */
+    template <class Locale>
+    static LocString resolveHandleUnlocked(const Locale &locale, std::string_view key)
+    {
+        if (catalog)
+        {
+            for (const Catalog::Table *table : {catalog->table(locale), catalog->table(DEFAULT_LOCALE_ID)})
+            {
+                if (!table)
+                    continue;
+                if (auto value = table->find(key))
+                    return LocString(std::shared_ptr<const char>(catalog, value->data()),
+                                     value->size(), catalog->generation, true);
+            }
+        }
+
+        auto missing = std::make_shared<std::string>("[Missing:");
+        missing->append(key).append("]");
+        std::size_t length = missing->size();
+        return LocString(std::shared_ptr<const char>(missing, missing->data()), length, 0, false);
+    }
+
+public:
+#if LOC_CERR == 0
+    static void setErrorCallback(ErrorCallback cb)
+    {
+        LOC_WRITE_LOCK
+        errorCallback = std::move(cb);
+    }
+#endif
+
+    /**
+     * @brief Delivers all queued errors on the calling thread.
+     *
+     * @details
+     * Called automatically when a loading function returns, unless the
+     * dispatcher thread is running. If another thread is already draining,
+     * returns immediately and leaves delivery to it.
+     *
+     * @return Number of delivered events.
+     */
+    static std::size_t drainErrors()
+    {
+        std::unique_lock<std::mutex> consumer(errorConsumerMutex, std::try_to_lock);
+        if (!consumer.owns_lock())
+            return 0;
+
+#if LOC_CERR == 0
+        ErrorCallback cb;
+        {
+            LOC_READ_LOCK
+            cb = errorCallback;
+        }
+#endif
+        std::size_t delivered = 0;
+        ErrorEvent event;
+        while (errorQueue.pop(event))
+        {
+            ++delivered;
+            try
+            {
+#if LOC_CERR == 0
+                if (cb)
+                    cb(event.message, event.code);
+                else
+                    DefaultErrorCallback(event.message, event.code);
+#else
+                std::cerr << "[ERR] " << event.message << " [CODE: " << event.code << "]\n";
+#endif
+            }
+            catch (...)
+            {
+                // A throwing callback must not lose the remaining events.
+            }
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Starts a background thread that delivers queued errors.
+     */
+    static void startErrorDispatcher()
+    {
+        std::lock_guard<std::mutex> guard(errorDispatcher.mtx);
+        if (errorDispatcher.running.exchange(true))
+            return;
+
+        errorDispatcher.worker = std::thread([]
+        {
+            using namespace std::chrono_literals;
+            while (errorDispatcher.running.load(std::memory_order_acquire))
+            {
+                drainErrors();
+                std::unique_lock<std::mutex> lk(errorDispatcher.mtx);
+                errorDispatcher.cv.wait_for(lk, 50ms, []
+                {
+                    return !errorDispatcher.running.load(std::memory_order_acquire) ||
+                           errorDispatcher.pending.exchange(false, std::memory_order_acq_rel);
+                });
+            }
+            drainErrors();
+        });
+    }
+
+    /**
+     * @brief Stops the dispatcher thread after delivering pending errors.
+     */
+    static void stopErrorDispatcher()
+    {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> guard(errorDispatcher.mtx);
+            if (!errorDispatcher.running.exchange(false))
+                return;
+            worker = std::move(errorDispatcher.worker);
+        }
+        errorDispatcher.cv.notify_one();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    /**
+     * @brief Returns the number of errors dropped because the queue was full.
+     */
+    [[nodiscard]] static std::uint64_t droppedErrorCount() noexcept
+    {
+        return errorQueue.droppedCount();
+    }
+
+    /**
+     * @brief Sets the upstream memory resource for catalog storage.
+     *
+     * @details
+     * Every catalog generation allocates its keys, values and lookup tables
+     * from a monotonic arena on top of this resource and returns the memory
+     * in one shot when the generation retires. Parse scratch space comes from
+     * the same resource. Applies from the next load or reload; the resource
+     * must be thread-safe and outlive every generation allocated from it.
+     *
+     * @param resource Resource to use, or nullptr for `std::pmr::get_default_resource()`.
+     */
+    static void setMemoryResource(std::pmr::memory_resource *resource) noexcept
+    {
+        memoryResource.store(resource, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the upstream memory resource for catalog storage.
+     * @return Configured resource, or the process default resource.
+     */
+    [[nodiscard]] static std::pmr::memory_resource *getMemoryResource() noexcept
+    {
+        return upstreamResource();
+    }
+
+    /**
+     * @brief Loads translation data from a single JSON file.
+     * @param path Path to the JSON file.
+     * @throws std::runtime_error If the file cannot be opened or parsed.
+     */
+    static void loadFromFile(const std::string &path)
+    {
+        ErrorFlush flush;
+        std::vector<ParsedFile> parsed;
+        parsed.push_back(parseFile(path, upstreamResource()));
+        commitParsed(std::move(parsed));
+    }
+
+    /**
+     * @brief Loads all JSON translation files from a directory.
+     * @param folderPath Directory containing language JSONs.
+     * @param recursive Whether to include subdirectories.
+     * @throws std::runtime_error If directory does not exist.
+     */
+    static void loadFromDirectory(const std::string &folderPath, bool recursive = false)
+    {
+        ErrorFlush flush;
+        commitParsed(parseFiles(collectJsonFiles(folderPath, recursive), "[!] Failed to load ", 1));
+    }
+
+#if LOC_USE_COROUTINES
+    /**
+     * @class CatalogAwaitable
+     * @brief Awaitable that runs a catalog job on a worker scheduler and resumes on the caller's executor.
+     *
+     * @details
+     * `co_await` yields the committed generation number, or rethrows the
+     * exception raised by the job (e.g. a missing directory).
+     *
+     * @tparam Executor Scheduler the awaiting coroutine is resumed on.
+     * @tparam Pool Scheduler the parse/flatten work runs on (stored by value unless an lvalue was passed).
+     */
+    template <LocalizerScheduler Executor, class Pool>
+    class CatalogAwaitable
+    {
+        Executor &executor;                  ///< Resumption executor.
+        Pool pool;                           ///< Worker scheduler.
+        std::function<std::uint64_t()> job;  ///< Work to run off the caller's thread.
+        std::uint64_t generation = 0;        ///< Result of the job.
+        std::exception_ptr error;            ///< Exception thrown by the job.
+
+    public:
+        CatalogAwaitable(Executor &executor, Pool &&pool, std::function<std::uint64_t()> job)
+            : executor(executor), pool(std::forward<Pool>(pool)), job(std::move(job)) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            pool.post([this, handle]
+            {
+                try
+                {
+                    generation = job();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                executor.post([handle] { handle.resume(); });
+            });
+        }
+
+        std::uint64_t await_resume()
+        {
+            if (error)
+                std::rethrow_exception(error);
+            return generation;
+        }
+    };
+
+    /**
+     * @brief Awaitable variant of loadFromDirectory().
+     *
+     * @details
+     * Directory listing, parsing and flattening run on `pool` without the
+     * lock; only the merge and commit take the write lock. The coroutine is
+     * resumed on `executor` once the new generation is live.
+     *
+     * @code
+     * std::uint64_t gen = co_await Localizer::loadAsync("langs", ioExecutor);
+     * @endcode
+     *
+     * @param folderPath Directory containing language JSONs.
+     * @param executor Scheduler the awaiting coroutine is resumed on.
+     * @param pool Scheduler for the parse work (a detached thread by default).
+     * @param recursive Whether to include subdirectories.
+     * @return Awaitable yielding the committed generation number.
+     */
+    template <LocalizerScheduler Executor, class Pool = DetachedThreadScheduler>
+        requires LocalizerScheduler<std::remove_reference_t<Pool>>
+    [[nodiscard]] static auto loadAsync(std::string folderPath, Executor &executor,
+                                        Pool &&pool = Pool{}, bool recursive = false)
+    {
+        return CatalogAwaitable<Executor, Pool>(executor, std::forward<Pool>(pool),
+                                                [folderPath = std::move(folderPath), recursive]
+                                                {
+                                                    ErrorFlush flush;
+                                                    return commitParsed(parseFiles(collectJsonFiles(folderPath, recursive),
+                                                                                   "[!] Failed to load ", 1));
+                                                });
+    }
+
+    /**
+     * @brief Awaitable variant of reloadAllJsons().
+     * @param executor Scheduler the awaiting coroutine is resumed on.
+     * @param pool Scheduler for the parse work (a detached thread by default).
+     * @param clearBefore If true, clears all existing translations before reload.
+     * @return Awaitable yielding the committed generation number.
+     */
+    template <LocalizerScheduler Executor, class Pool = DetachedThreadScheduler>
+        requires LocalizerScheduler<std::remove_reference_t<Pool>>
+    [[nodiscard]] static auto reloadAsync(Executor &executor, Pool &&pool = Pool{}, bool clearBefore = false)
+    {
+        return CatalogAwaitable<Executor, Pool>(executor, std::forward<Pool>(pool),
+                                                [clearBefore]
+                                                {
+                                                    ErrorFlush flush;
+                                                    return commitParsed(parseFiles(loadedFiles(), "[!] Failed to reload ", 2),
+                                                                        clearBefore);
+                                                });
+    }
+#endif
+
+    /**
+     * @brief Reloads all loaded JSON files.
+     * @param clearBefore If true, clears all existing translations before reload.
+     */
+    static void reloadAllJsons(bool clearBefore = false)
+    {
+        ErrorFlush flush;
+        commitParsed(parseFiles(loadedFiles(), "[!] Failed to reload ", 2), clearBefore);
+    }
+
+    /**
+     * @brief Stacks a patch file above the loaded catalogs as a named overlay.
+     *
+     * @details
+     * Overlays take precedence over every loaded file; among overlays, the
+     * one added last wins. Adding a layer under an existing name replaces it
+     * in place, keeping its precedence. Overlays survive reloads (including
+     * `reloadAllJsons(true)`) and are not watched for changes: call
+     * addOverlay() again to refresh one. Any format accepted by
+     * loadFromFile() except `.mo` can be used.
+     *
+     * Keys are namespaced by the patch file's own stem, not by the layer
+     * name: a patch for `ui.*` keys must be named `ui.json` (or `ui.csv`...).
+     * Patches for several namespaces need one layer per file.
+     *
+     * The new generation references the base tables and only builds the
+     * merged overlay tables, so the cost is proportional to the overlays.
+     *
+     * @param name Layer name.
+     * @param path Patch file.
+     * @throws std::runtime_error If the file cannot be opened or parsed.
+     */
+    static void addOverlay(const std::string &name, const std::string &path)
+    {
+        ErrorFlush flush;
+        ParsedFile parsed = parseFile(path, upstreamResource());
+        if (parsed.mo)
+            throw std::runtime_error("Overlays cannot be .mo files: " + path);
+        LOC_WRITE_LOCK
+        commitOverlayUnlocked(name, std::move(parsed));
+    }
+
+    /**
+     * @brief Stacks API-provided overrides above the loaded catalogs as a named overlay.
+     * @param name Layer name.
+     * @param locale Language code.
+     * @param entries Full key → value pairs.
+     * @see addOverlay(const std::string &, const std::string &)
+     */
+    static void addOverlay(const std::string &name, const std::string &locale,
+                           const std::unordered_map<std::string, std::string> &entries)
+    {
+        ErrorFlush flush;
+        ParsedFile parsed(upstreamResource());
+        auto &target = parsed.locales.emplace_back(std::piecewise_construct,
+                                                   std::forward_as_tuple(locale),
+                                                   std::forward_as_tuple()).second;
+        for (const auto &[key, value] : entries)
+            target.insert_or_assign(std::pmr::string(key, parsed.arena.get()), std::pmr::string(value, parsed.arena.get()));
+        LOC_WRITE_LOCK
+        commitOverlayUnlocked(name, std::move(parsed));
+    }
+
+    /**
+     * @brief Removes a named overlay.
+     * @param name Layer name.
+     * @return true if the layer existed.
+     */
+    static bool removeOverlay(const std::string &name)
+    {
+        ErrorFlush flush;
+        LOC_WRITE_LOCK
+        auto it = std::find_if(overlays.begin(), overlays.end(), [&name](const Overlay &o) { return o.name == name; });
+        if (it == overlays.end())
+            return false;
+        overlays.erase(it);
+        catalog = composeOverlays(baseCatalog);
+        publishSnapshots();
+        return true;
+    }
+
+    /**
+     * @brief Returns the overlay names, lowest precedence first.
+     * @return Layer names.
+     */
+    [[nodiscard]] static std::vector<std::string> overlayNames()
+    {
+        LOC_READ_LOCK
+        std::vector<std::string> names;
+        names.reserve(overlays.size());
+        for (const Overlay &o : overlays)
+            names.push_back(o.name);
+        return names;
+    }
+
+    /**
+     * @brief Checks for modified JSON files and reloads changed ones.
+     */
+    static void checkForJsonChanges()
+    {
+        ErrorFlush flush;
+        LOC_WRITE_LOCK
+        std::vector<ParsedFile> parsed;
+        for (auto &[path, oldTime] : fileTimestamps)
+        {
+            if (!std::filesystem::exists(path))
+                continue;
+            auto newTime = std::filesystem::last_write_time(path);
+            if (newTime != oldTime)
+            {
+                oldTime = newTime;
+                std::cout << "🔁 Detected change in " << path << std::endl;
+                parsed.push_back(parseFile(path, upstreamResource()));
+            }
+        }
+        if (!parsed.empty())
+            commitParsedUnlocked(parsed, false);
+    }
+
+    /**
+     * @brief Returns a descriptor that becomes readable when a new catalog generation is committed.
+     *
+     * @details
+     * Register it with `epoll`/`poll`/`select` for read readiness, then call
+     * consumeChanges() to reset it. The descriptor is owned by the library
+     * and must not be closed by the caller.
+     *
+     * @return File descriptor, or -1 if unsupported on this platform.
+     */
+    [[nodiscard]] static int changeNotificationFd()
+    {
+#if defined(_WIN32)
+        return -1;
+#else
+        std::lock_guard<std::mutex> guard(changeNotifier.mtx);
+        int fd = changeNotifier.readFd.load();
+        if (fd >= 0)
+            return fd;
+
+#if defined(__linux__)
+        fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0)
+            return -1;
+        changeNotifier.writeFd = fd;
+#else
+        int fds[2];
+        if (::pipe(fds) != 0)
+            return -1;
+        for (int end : fds)
+        {
+            ::fcntl(end, F_SETFL, ::fcntl(end, F_GETFL) | O_NONBLOCK);
+            ::fcntl(end, F_SETFD, FD_CLOEXEC);
+        }
+        fd = fds[0];
+        changeNotifier.writeFd = fds[1];
+#endif
+        changeNotifier.readFd.store(fd, std::memory_order_release);
+
+        // Generations committed before the descriptor existed are still reported.
+        if (changeNotifier.committed.load() != changeNotifier.consumed.load())
+            notifyGenerationCommitted(changeNotifier.committed.load());
+        return fd;
+#endif
+    }
+
+    /**
+     * @brief Resets the notification descriptor and reports the newest generation.
+     *
+     * @details
+     * Non-blocking and lock-free with respect to the catalog lock; safe to
+     * call from an event loop whether or not the descriptor is readable.
+     *
+     * @return Newest committed generation if it changed since the last call, otherwise 0.
+     */
+    static std::uint64_t consumeChanges() noexcept
+    {
+#if !defined(_WIN32)
+        int fd = changeNotifier.readFd.load(std::memory_order_acquire);
+        if (fd >= 0)
+        {
+            char buf[64];
+            while (::read(fd, buf, sizeof(buf)) > 0)
+            {
+            }
+        }
+#endif
+        std::uint64_t committed = changeNotifier.committed.load(std::memory_order_acquire);
+        std::uint64_t previous = changeNotifier.consumed.exchange(committed, std::memory_order_acq_rel);
+        return committed != previous ? committed : 0;
+    }
+
+    /**
+     * @brief Returns the number of the most recently committed catalog generation.
+     * @return Generation number, 0 before anything was loaded.
+     */
+    [[nodiscard]] static std::uint64_t currentGeneration() noexcept
+    {
+        return changeNotifier.committed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Pins the current catalog generation.
+     * @return Pin keeping the generation's memory alive; see CatalogPin.
+     */
+    [[nodiscard]] static CatalogPin pin();
+
+    /**
+     * @brief Returns the wire fingerprint of the current catalog.
+     *
+     * @details
+     * Serialized messages carry the sender's fingerprint; two processes can
+     * exchange messages in the compact form only when their fingerprints match.
+     *
+     * @return Fingerprint, 0 before anything was loaded.
+     */
+    [[nodiscard]] static std::uint64_t catalogFingerprint()
+    {
+        LOC_READ_LOCK
+        return catalog ? catalog->fingerprint : 0;
+    }
+
+    /**
+     * @brief Sets current locale.
+     * @param locale Language code in any spelling (e.g., "en", "pt_BR", "zh-hant-tw").
+     * @return true if locale exists, false otherwise.
+     */
+    [[nodiscard]] static bool setLocale(const std::string &locale)
+    {
+        std::optional<LocaleId> id = findLocaleId(locale);
+        return id && setLocale(*id);
+    }
+
+    /**
+     * @brief Sets current locale by id.
+     * @param id Interned locale.
+     * @return true if locale exists, false otherwise.
+     */
+    [[nodiscard]] static bool setLocale(LocaleId id)
+    {
+        LOC_WRITE_LOCK
+        if (catalog && catalog->table(id))
+        {
+            currentLocaleId = id;
+            publishSnapshots(false);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Retrieves current locale.
+     * @return Canonical tag of the current locale.
+     */
+    [[nodiscard]] static std::string getLocale()
+    {
+        LOC_READ_LOCK
+        return std::string(localeName(currentLocaleId));
+    }
+
+    /**
+     * @brief Retrieves the id of the current locale.
+     * @return Current locale id.
+     */
+    [[nodiscard]] static LocaleId getLocaleId() noexcept
+    {
+        LOC_READ_LOCK
+        return currentLocaleId;
+    }
+
+    /**
+     * @brief Picks the loaded locale that best satisfies an HTTP `Accept-Language` header.
+     *
+     * @details
+     * Ranges are honoured in q-value order, each trying its BCP-47 truncation
+     * chain and then any loaded locale with the same primary language.
+     * Tags resolve through findLocaleId(), so legacy tags and aliases count.
+     * Results are cached per header text (`LOC_NEGOTIATION_CACHE_SIZE`
+     * slots) until the catalog changes or an alias is added, so a repeated
+     * header costs one hash lookup. Does not change the current locale;
+     * pass the result to translateHandleIn() or a CatalogPin.
+     *
+     * @param acceptLanguage Header value, e.g. "fr-CH, fr;q=0.9, en;q=0.8".
+     * @return Negotiated locale, or the default locale when nothing matches.
+     */
+    [[nodiscard]] static std::string negotiateLocale(std::string_view acceptLanguage)
+    {
+        LOC_READ_LOCK
+        if (!catalog)
+            return DEFAULT_LOCALE;
+
+        const std::uint64_t hash = hashKey(acceptLanguage);
+        const std::uint64_t generation = catalog->generation;
+        const std::uint64_t aliases = localeRegistry.aliases.load(std::memory_order_acquire);
+        const bool cacheable = acceptLanguage.size() <= NegotiationCache::MAX_HEADER;
+        const std::size_t index = static_cast<std::size_t>(hash % LOC_NEGOTIATION_CACHE_SIZE);
+        NegotiationCache::Slot &slot = negotiationCache.slots[index];
+
+        if (cacheable)
+        {
+#if LOC_THREAD_SAFE
+            std::shared_lock<std::shared_mutex> guard(negotiationCache.locks[index % NegotiationCache::STRIPES]);
+#endif
+            if (slot.generation == generation && slot.aliases == aliases && slot.hash == hash &&
+                slot.header == acceptLanguage)
+                return slot.locale;
+        }
+
+        std::string locale(negotiateUnlocked(acceptLanguage));
+        if (cacheable)
+        {
+#if LOC_THREAD_SAFE
+            std::unique_lock<std::shared_mutex> guard(negotiationCache.locks[index % NegotiationCache::STRIPES]);
+#endif
+            slot.hash = hash;
+            slot.generation = generation;
+            slot.aliases = aliases;
+            slot.header.assign(acceptLanguage);
+            slot.locale = locale;
+        }
+        return locale;
+    }
+
+    /**
+     * @brief Translates a key into localized text.
+     * @param key Translation key (e.g., "ui.button.play").
+     * @return Localized string or missing-key placeholder.
+     */
+    [[nodiscard]] static std::string translate(const std::string &key)
+    {
+        return translateAs<std::string>(key, {});
+    }
+
+    /**
+     * @brief Translates one variant of a variant set (`{ "_variants": ["A", "B", "C"] }`).
+     *
+     * @details
+     * All variants of a key sit contiguously behind one table entry, so
+     * selection is a single lookup plus an index. Keys without variants
+     * translate as usual, and translate() returns the first variant.
+     *
+     * @param key Translation key.
+     * @param variant Variant index; out of range selects the first variant.
+     * @return Localized string or missing-key placeholder.
+     */
+    [[nodiscard]] static std::string translateVariant(const std::string &key, std::size_t variant)
+    {
+        VariantPick pick{variant, false};
+        return translateAs<std::string>(key, {}, &pick);
+    }
+
+    /**
+     * @brief Translates the variant a bucketing id (user, session, device) is assigned to.
+     *
+     * @details
+     * The assignment is a hash of the key and the id, identical across runs
+     * and platforms, so an id keeps its variant for as long as the number of
+     * variants does not change. Different keys bucket independently.
+     *
+     * @param key Translation key.
+     * @param bucketId Stable identifier to bucket on.
+     * @return Localized string or missing-key placeholder.
+     */
+    [[nodiscard]] static std::string translateBucketed(const std::string &key, std::string_view bucketId)
+    {
+        VariantPick pick{variantHash(key, bucketId), true};
+        return translateAs<std::string>(key, {}, &pick);
+    }
+
+    /**
+     * @brief Returns the number of variants of a key in the current or default locale.
+     * @param key Translation key.
+     * @return Variant count, 0 if the key is missing or not a variant set.
+     */
+    [[nodiscard]] static std::size_t variantCount(std::string_view key) noexcept
+    {
+        LOC_READ_LOCK
+        const LocValue *set = catalog ? catalog->resolveVariants(currentLocaleId, key) : nullptr;
+        return set ? set->size() : 0;
+    }
+
+    /**
+     * @brief Bucketing hash used by translateBucketed().
+     * @param key Translation key.
+     * @param bucketId Stable identifier to bucket on.
+     * @return Hash; the variant is `hash % variantCount(key)`.
+     */
+    [[nodiscard]] static constexpr std::uint64_t variantHash(std::string_view key, std::string_view bucketId) noexcept
+    {
+        std::uint64_t x = hashKey(bucketId) ^ hashKey(key) * 0x9e3779b97f4a7c15ull;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        return x ^ (x >> 33);
+    }
+
+    /**
+     * @brief Translates a key into localized text allocated from a memory resource.
+     * @param key Translation key (e.g., "ui.button.play").
+     * @param resource Resource for the returned string.
+     * @return Localized string or missing-key placeholder.
+     */
+    [[nodiscard]] static std::pmr::string translate(const std::string &key, std::pmr::memory_resource *resource)
+    {
+        return translateAs<std::pmr::string>(key, std::pmr::polymorphic_allocator<char>(resource));
+    }
+
+    /**
+     * @brief Returns the display metrics of a key's value in the current locale.
+     *
+     * @details
+     * Metrics are computed once when the catalog is loaded, so this costs a
+     * lookup, not a scan of the text. Falls back to the default locale like
+     * translate(); debug decorations are not included.
+     *
+     * @param key Translation key.
+     * @return Metrics of the value, or of the `[Missing:key]` marker.
+     */
+    [[nodiscard]] static TextMetrics translateMetrics(std::string_view key)
+    {
+        LOC_READ_LOCK
+        if (catalog)
+        {
+            std::uint64_t hash = hashKey(key);
+            for (const Catalog::Table *table : {catalog->table(currentLocaleId), catalog->table(DEFAULT_LOCALE_ID)})
+                if (table)
+                    if (auto value = table->findMeasured(key, hash))
+                        return value->metrics;
+        }
+        return missingMetrics(key);
+    }
+
+    /**
+     * @brief Translates a key to UTF-16 without converting on every call.
+     *
+     * @details
+     * The UTF-16 copy is made once per value and catalog generation, on the
+     * first request (or at commit for namespaces passed to
+     * setPreencodedNamespaces()); later calls return the cached copy. Falls
+     * back to the default locale; debug decorations are not applied.
+     *
+     * @param key Translation key.
+     * @return Handle to the text; `handle.view()` is a std::u16string_view.
+     */
+    [[nodiscard]] static LocU16String translateU16(std::string_view key)
+    {
+        return translateWide<char16_t>(key);
+    }
+
+    /**
+     * @brief Translates a key to UTF-32; see translateU16().
+     * @param key Translation key.
+     * @return Handle to the text; `handle.view()` is a std::u32string_view.
+     */
+    [[nodiscard]] static LocU32String translateU32(std::string_view key)
+    {
+        return translateWide<char32_t>(key);
+    }
+
+    /**
+     * @brief Selects namespaces whose UTF-16/UTF-32 copies are built eagerly.
+     *
+     * @details
+     * Applies to the current catalog immediately and to every generation
+     * committed afterwards, so the first translateU16() of those keys does
+     * not pay for the conversion. Other keys are still encoded on demand.
+     *
+     * @param namespaces Namespaces (file names), e.g. {"ui", "hud"}; empty to disable.
+     * @param utf16 Build UTF-16 copies.
+     * @param utf32 Build UTF-32 copies.
+     */
+    static void setPreencodedNamespaces(const std::vector<std::string> &namespaces, bool utf16 = true, bool utf32 = false)
+    {
+        LOC_WRITE_LOCK
+        preencoded.prefixes.clear();
+        for (const std::string &ns : namespaces)
+            preencoded.prefixes.push_back(ns + LOC_NAMESPACE_SEPARATOR);
+        preencoded.utf16 = utf16;
+        preencoded.utf32 = utf32;
+        preencodeUnlocked(true);
+    }
+
+    /**
+     * @brief Interns a key and returns its process-local id.
+     * @param key Translation key.
+     * @return Id, stable for the lifetime of the process.
+     */
+    [[nodiscard]] static KeyId internKey(std::string_view key)
+    {
+        {
+#if LOC_THREAD_SAFE
+            std::shared_lock<std::shared_mutex> guard(keyRegistry.mtx);
+#endif
+            if (auto it = keyRegistry.ids.find(key); it != keyRegistry.ids.end())
+                return it->second;
+        }
+#if LOC_THREAD_SAFE
+        std::unique_lock<std::shared_mutex> guard(keyRegistry.mtx);
+#endif
+        if (auto it = keyRegistry.ids.find(key); it != keyRegistry.ids.end())
+            return it->second;
+        auto id = static_cast<KeyId>(keyRegistry.names.size());
+        const std::string &stored = keyRegistry.names.emplace_back(key);
+        keyRegistry.ids.emplace(stored, id);
+        return id;
+    }
+
+    /**
+     * @brief Returns the key text of an interned id.
+     * @param id Id returned by internKey().
+     * @return Key text (valid for the process lifetime), or an empty view for unknown ids.
+     */
+    [[nodiscard]] static std::string_view keyName(KeyId id)
+    {
+#if LOC_THREAD_SAFE
+        std::shared_lock<std::shared_mutex> guard(keyRegistry.mtx);
+#endif
+        return id < keyRegistry.names.size() ? std::string_view(keyRegistry.names[id]) : std::string_view();
+    }
+
+    /**
+     * @brief Keeps per-key metadata up to date during loads.
+     *
+     * @details
+     * Off by default: loads then skip `_meta` entirely and keyMetadata()
+     * re-reads the source files on its first call after each reload. Turning
+     * it on reads the already loaded files once and makes later JSON loads
+     * collect metadata while parsing, at the cost of a key scan per load.
+     *
+     * @param enabled Whether loads collect metadata.
+     */
+    static void setKeyMetadataEnabled(bool enabled)
+    {
+        metadataEnabled.store(enabled, std::memory_order_relaxed);
+        if (enabled)
+            loadMetadata();
+    }
+
+    /**
+     * @brief Returns tooling metadata of a key: translator context, length hint, source and generation.
+     *
+     * @details
+     * Metadata lives in a cold table outside the catalog, so translate() is
+     * unaffected by it. The first call after a reload may read the source
+     * files (see setKeyMetadataEnabled()). Only JSON sources carry metadata.
+     *
+     * @param id Key id from internKey().
+     * @return Copy of the metadata, or std::nullopt if no loaded JSON defines or describes the key.
+     */
+    [[nodiscard]] static std::optional<KeyMetadata> keyMetadata(KeyId id)
+    {
+        return findMetadata([id] { return std::optional<KeyId>(id); });
+    }
+
+    /// @copydoc keyMetadata(KeyId)
+    [[nodiscard]] static std::optional<KeyMetadata> keyMetadata(std::string_view key)
+    {
+        // Keys with metadata are interned when the table is filled, so unknown keys need not be.
+        return findMetadata([key] { return findKeyId(key); });
+    }
+
+    /**
+     * @brief Normalizes a locale tag to its canonical BCP-47 spelling.
+     *
+     * @details
+     * '_' becomes '-', a POSIX codeset or modifier ("de_DE.UTF-8@euro") is
+     * dropped, and subtags get their conventional case: language lowercase,
+     * script titlecase, region uppercase ("zh_hant_tw" → "zh-Hant-TW").
+     * Deprecated and grandfathered tags are replaced by their preferred
+     * values ("iw" → "he", "i-klingon" → "tlh").
+     *
+     * @param tag Locale tag in any spelling.
+     * @return Canonical tag.
+     */
+    [[nodiscard]] static std::string canonicalLocale(std::string_view tag)
+    {
+        std::string out;
+        canonicalizeLocale(tag, out);
+        return out;
+    }
+
+private:
+    /**
+     * @brief canonicalLocale() into a caller-owned buffer, so hot lookups can reuse its capacity.
+     * @param tag Locale tag in any spelling.
+     * @param out Receives the canonical tag.
+     */
+    static void canonicalizeLocale(std::string_view tag, std::string &out)
+    {
+        static constexpr std::pair<std::string_view, std::string_view> legacyTags[] = {
+            {"art-lojban", "jbo"}, {"en-GB-oed", "en-GB-oxendict"}, {"i-ami", "ami"}, {"i-bnn", "bnn"},
+            {"i-hak", "hak"}, {"i-klingon", "tlh"}, {"i-lux", "lb"}, {"i-navajo", "nv"}, {"i-pwn", "pwn"},
+            {"i-tao", "tao"}, {"i-tay", "tay"}, {"i-tsu", "tsu"}, {"no-bok", "nb"}, {"no-nyn", "nn"},
+            {"sgn-BE-FR", "sfb"}, {"sgn-BE-NL", "vgt"}, {"sgn-CH-DE", "sgg"}, {"zh-guoyu", "zh"},
+            {"zh-hakka", "hak"}, {"zh-min-nan", "nan"}, {"zh-xiang", "hsn"}};
+        static constexpr std::pair<std::string_view, std::string_view> legacyLanguages[] = {
+            {"in", "id"}, {"iw", "he"}, {"ji", "yi"}, {"jw", "jv"}, {"mo", "ro"}};
+
+        tag = tag.substr(0, tag.find_first_of(".@"));
+        out.clear();
+        out.reserve(tag.size());
+        bool privateUse = false;
+        for (std::size_t start = 0; start <= tag.size();)
+        {
+            std::size_t end = std::min(tag.find_first_of("-_", start), tag.size());
+            std::string_view subtag = tag.substr(start, end - start);
+            start = end + 1;
+            if (subtag.empty())
+                continue;
+
+            bool first = out.empty();
+            if (!first)
+                out += '-';
+            std::size_t at = out.size();
+            for (char c : subtag)
+                out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (first || privateUse)
+                continue;
+            if (subtag.size() == 1)
+                privateUse = true; // extension or private use: everything after stays lowercase
+            else if (subtag.size() == 4 && std::isalpha(static_cast<unsigned char>(subtag[0])))
+                out[at] = static_cast<char>(std::toupper(static_cast<unsigned char>(out[at])));
+            else if (subtag.size() == 2)
+                for (std::size_t i = at; i < out.size(); ++i)
+                    out[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(out[i])));
+        }
+
+        for (const auto &[legacy, preferred] : legacyTags)
+            if (languageTagEquals(out, legacy))
+            {
+                out.assign(preferred);
+                return;
+            }
+        std::string_view language = std::string_view(out).substr(0, out.find('-'));
+        for (const auto &[legacy, preferred] : legacyLanguages)
+            if (language == legacy)
+            {
+                out.replace(0, legacy.size(), preferred);
+                return;
+            }
+    }
+
+public:
+    /**
+     * @brief Looks up the id of a locale tag without interning it.
+     * @param tag Locale tag in any spelling, or a registered alias.
+     * @return Id, or std::nullopt when the locale was never interned.
+     */
+    [[nodiscard]] static std::optional<LocaleId> findLocaleId(std::string_view tag)
+    {
+        auto find = [](std::string_view spelling) -> std::optional<LocaleId>
+        {
+#if LOC_THREAD_SAFE
+            std::shared_lock<std::shared_mutex> guard(localeRegistry.mtx);
+#endif
+            if (auto it = localeRegistry.ids.find(spelling); it != localeRegistry.ids.end())
+                return it->second;
+            return std::nullopt;
+        };
+        if (std::optional<LocaleId> id = find(tag))
+            return id;
+        // Misses are common (unsupported locales in Accept-Language); reuse one buffer per thread.
+        thread_local std::string canonical;
+        canonicalizeLocale(tag, canonical);
+        if (canonical == tag)
+            return std::nullopt;
+        return find(canonical);
+    }
+
+    /**
+     * @brief Interns a locale tag and returns the id of its canonical form.
+     *
+     * @details
+     * "en_US", "en-us" and "EN-US" share one id. Catalog locales are interned
+     * when loaded, so ids can be compared and used as indices instead of
+     * hashing locale strings on every lookup.
+     *
+     * @param tag Locale tag in any spelling.
+     * @return Id, stable for the lifetime of the process.
+     * @throws std::length_error If all 65536 locale ids are taken.
+     */
+    [[nodiscard]] static LocaleId internLocale(std::string_view tag)
+    {
+        if (std::optional<LocaleId> id = findLocaleId(tag))
+            return *id;
+        std::string canonical = canonicalLocale(tag);
+#if LOC_THREAD_SAFE
+        std::unique_lock<std::shared_mutex> guard(localeRegistry.mtx);
+#endif
+        if (auto it = localeRegistry.ids.find(canonical); it != localeRegistry.ids.end())
+            return it->second;
+        if (localeRegistry.names.size() > std::numeric_limits<LocaleId>::max())
+            throw std::length_error("Localizer: locale registry is full");
+        auto id = static_cast<LocaleId>(localeRegistry.names.size());
+        const std::string &stored = localeRegistry.texts.emplace_back(std::move(canonical));
+        localeRegistry.names.push_back(stored);
+        localeRegistry.ids.emplace(stored, id);
+        return id;
+    }
+
+    /**
+     * @brief Returns the canonical tag of an interned locale.
+     * @param id Id returned by internLocale().
+     * @return Tag (valid for the process lifetime), or an empty view for unknown ids.
+     */
+    [[nodiscard]] static std::string_view localeName(LocaleId id)
+    {
+#if LOC_THREAD_SAFE
+        std::shared_lock<std::shared_mutex> guard(localeRegistry.mtx);
+#endif
+        return id < localeRegistry.names.size() ? localeRegistry.names[id] : std::string_view();
+    }
+
+    /**
+     * @brief Makes an additional tag resolve to an existing locale.
+     *
+     * @details
+     * Useful for legacy or regional tags that should share a catalog, e.g.
+     * `addLocaleAlias("zh-TW", "zh-Hant-TW")`. The alias is canonicalized
+     * before it is stored.
+     *
+     * @param alias Tag to redirect.
+     * @param target Tag it stands for.
+     * @return false if `alias` is already a locale of its own.
+     */
+    [[nodiscard]] static bool addLocaleAlias(std::string_view alias, std::string_view target)
+    {
+        LocaleId id = internLocale(target);
+        std::string canonical = canonicalLocale(alias);
+#if LOC_THREAD_SAFE
+        std::unique_lock<std::shared_mutex> guard(localeRegistry.mtx);
+#endif
+        if (auto it = localeRegistry.ids.find(canonical); it != localeRegistry.ids.end())
+            return it->second == id;
+        const std::string &stored = localeRegistry.texts.emplace_back(std::move(canonical));
+        localeRegistry.ids.emplace(stored, id);
+        localeRegistry.aliases.fetch_add(1, std::memory_order_release); // invalidates cached negotiations
+        return true;
+    }
+
+    /**
+     * @brief Resolves a key in an explicit locale, independent of the current locale.
+     *
+     * @details
+     * Falls back to the default locale. Debug decorations are not applied.
+     * Safe to call from any thread, e.g. a logging backend rendering in the
+     * reader's locale.
+     *
+     * @param locale Language code.
+     * @param key Translation key.
+     * @return Handle to the value, or to a `[Missing:key]` marker.
+     */
+    [[nodiscard]] static LocString translateHandleIn(std::string_view locale, std::string_view key)
+    {
+        LOC_READ_LOCK
+        return resolveHandleUnlocked(locale, key);
+    }
+
+    /**
+     * @brief Resolves a key to a handle into the current catalog generation.
+     *
+     * @details
+     * Unlike translate(), no text is copied: the handle references the
+     * generation's storage and keeps it alive across reloads. Debug
+     * decorations are not applied. A missing key yields a handle to a
+     * separately allocated `[Missing:key]` marker with found() == false.
+     *
+     * @param key Translation key.
+     * @return Handle to the localized value.
+     */
+    [[nodiscard]] static LocString translateHandle(std::string_view key)
+    {
+        LOC_READ_LOCK
+        return resolveHandleUnlocked(currentLocaleId, key);
+    }
+
+    /**
+     * @brief Checks if the key exists in current or default locale.
+     * @param key Translation key.
+     * @return true if key exists.
+     */
+    [[nodiscard]] static bool hasKey(const std::string &key) noexcept
+    {
+        LOC_READ_LOCK
+        return findValueUnlocked(currentLocaleId, key).has_value() ||
+               findValueUnlocked(DEFAULT_LOCALE_ID, key).has_value();
+    }
+
+    /**
+     * @brief Reads an integer leaf (`"max_items": 20`) in current or default locale.
+     * @param key Translation key.
+     * @return Value, or std::nullopt if the key is missing or not an integer.
+     */
+    [[nodiscard]] static std::optional<std::int64_t> getInt(std::string_view key) noexcept
+    {
+        LOC_READ_LOCK
+        const LocValue *value = catalog ? catalog->resolveTyped(currentLocaleId, key) : nullptr;
+        return value ? value->asInt() : std::nullopt;
+    }
+
+    /**
+     * @brief Reads a numeric leaf in current or default locale.
+     * @param key Translation key.
+     * @return Value (integers converted), or std::nullopt if the key is missing or not a number.
+     */
+    [[nodiscard]] static std::optional<double> getDouble(std::string_view key) noexcept
+    {
+        LOC_READ_LOCK
+        const LocValue *value = catalog ? catalog->resolveTyped(currentLocaleId, key) : nullptr;
+        return value ? value->asDouble() : std::nullopt;
+    }
+
+    /**
+     * @brief Reads a boolean leaf (`"rtl": true`) in current or default locale.
+     * @param key Translation key.
+     * @return Value, or std::nullopt if the key is missing or not a boolean.
+     */
+    [[nodiscard]] static std::optional<bool> getBool(std::string_view key) noexcept
+    {
+        LOC_READ_LOCK
+        const LocValue *value = catalog ? catalog->resolveTyped(currentLocaleId, key) : nullptr;
+        return value ? value->asBool() : std::nullopt;
+    }
+
+    /**
+     * @brief Reads an array leaf (`"months": ["Jan", ...]`) in current or default locale.
+     *
+     * @details
+     * The handle shares ownership of the catalog generation: no element is
+     * copied and it stays valid across reloads.
+     *
+     * @param key Translation key.
+     * @return Handle, or std::nullopt if the key is missing or not an array.
+     */
+    [[nodiscard]] static std::optional<LocArray> getArray(std::string_view key)
+    {
+        LOC_READ_LOCK
+        const LocValue *value = catalog ? catalog->resolveTyped(currentLocaleId, key) : nullptr;
+        if (!value || value->type() != LocValue::Type::Array)
+            return std::nullopt;
+        return LocArray(std::shared_ptr<const LocValue>(catalog, value->begin()), value->size());
+    }
+
+    /**
+     * @brief Translates a key into a caller-provided buffer with bounded latency.
+     *
+     * @details
+     * Intended for render and audio threads. Guarantees:
+     * - wait-free: never blocks on the catalog lock, reloads or `setLocale`;
+     * - no allocation and no exceptions;
+     * - output is NUL-terminated whenever `capacity > 0`, truncation happens
+     *   on a UTF-8 boundary and is reported in the result.
+     *
+     * Debug decorations are not applied. A missing key writes `[Missing:key]`.
+     * Reloads wait for in-flight realtime readers before freeing the previous
+     * catalog, so a reader always sees one consistent generation.
+     *
+     * @param key Translation key.
+     * @param out Destination buffer.
+     * @param capacity Size of the destination buffer in bytes.
+     * @return Written length, lookup and truncation status.
+     */
+    static RealtimeResult translateRealtime(std::string_view key, char *out, std::size_t capacity) noexcept
+    {
+        return withRealtimeValue(key, [&](std::optional<std::string_view> found) noexcept
+                                 { return writeRealtime(key, found, out, capacity); });
+    }
+
+private:
+    /**
+     * @brief Resolves a key through the realtime view and hands the value to `f`.
+     *
+     * @details
+     * Takes no lock and does not allocate. `f` runs while the view is
+     * pinned, so reloads wait for it to return; it must not take the
+     * catalog lock.
+     *
+     * @param key Translation key.
+     * @param f Called with the value in the current or default locale, or with std::nullopt.
+     * @return What `f` returns.
+     */
+    template <class F>
+    static std::invoke_result_t<F &, std::optional<std::string_view>> withRealtimeValue(std::string_view key, F &&f)
+    {
+        struct Reader
+        {
+            unsigned parity;
+            ~Reader() { realtimeReaders[parity].fetch_sub(1); }
+        } reader{realtimeEpoch.load() & 1u};
+        realtimeReaders[reader.parity].fetch_add(1);
+
+        std::optional<std::string_view> value;
+        if (const RealtimeView *view = realtimeView.load())
+        {
+            for (const Catalog::Table *table : {view->current, view->fallback})
+                if (table && (value = table->find(key)))
+                    break;
+        }
+        return f(value);
+    }
+
+    /// Body of translateRealtime(), run with the realtime view pinned.
+    static RealtimeResult writeRealtime(std::string_view key, std::optional<std::string_view> value, char *out,
+                                        std::size_t capacity) noexcept
+    {
+        RealtimeResult result;
+        result.found = value.has_value();
+        std::size_t written = 0;
+        auto put = [&](std::string_view part)
+        {
+            if (capacity == 0 || result.truncated)
+            {
+                result.truncated = result.truncated || !part.empty();
+                return;
+            }
+            std::size_t room = capacity - 1 - written;
+            std::size_t n = part.size();
+            if (n > room)
+            {
+                n = room;
+                while (n > 0 && (static_cast<unsigned char>(part[n]) & 0xC0) == 0x80)
+                    --n; // do not cut a UTF-8 sequence in half
+                result.truncated = true;
+            }
+            std::memcpy(out + written, part.data(), n);
+            written += n;
+        };
+
+        if (result.found)
+        {
+            put(*value);
+        }
+        else
+        {
+            put("[Missing:");
+            put(key);
+            put("]");
+        }
+
+        if (capacity > 0)
+            out[written] = '\0';
+        result.length = written;
+        return result;
+    }
+
+public:
+    /**
+     * @brief Registers a key whose value is prerendered for signal handlers.
+     *
+     * @details
+     * The value for the current locale (falling back to the default locale)
+     * is copied into static storage and refreshed on every reload and locale
+     * switch. Values longer than `LOC_SIGNAL_SAFE_VALUE_SIZE - 1` bytes are
+     * truncated on a UTF-8 boundary.
+     *
+     * @param key Translation key, shorter than `LOC_SIGNAL_SAFE_KEY_SIZE`.
+     * @return Slot index, or -1 if the table is full or the key is too long.
+     */
+    static int registerSignalSafeKey(const std::string &key)
+    {
+        ErrorFlush flush;
+        LOC_WRITE_LOCK
+        for (std::size_t i = 0; i < signalSafeKeys.size(); ++i)
+            if (signalSafeKeys[i] == key)
+                return static_cast<int>(i);
+
+        if (signalSafeKeys.size() >= LOC_SIGNAL_SAFE_SLOTS || key.size() >= LOC_SIGNAL_SAFE_KEY_SIZE)
+        {
+            LOC_RAISE_ERROR("Cannot register signal-safe key: " + key, 3);
+            return -1;
+        }
+
+        signalSafeKeys.push_back(key);
+        refreshSignalSafeTable();
+        return static_cast<int>(signalSafeKeys.size() - 1);
+    }
+
+    /**
+     * @brief Copies a prerendered message into a caller buffer.
+     *
+     * @details
+     * Async-signal-safe: no allocation, no locks, no exceptions. The result
+     * is NUL-terminated whenever `capacity > 0`.
+     *
+     * @param slot Slot index returned by registerSignalSafeKey().
+     * @param out Destination buffer.
+     * @param capacity Size of the destination buffer in bytes.
+     * @return Number of bytes copied, excluding the terminator.
+     */
+    static std::size_t copySignalSafeMessage(std::size_t slot, char *out, std::size_t capacity) noexcept
+    {
+        unsigned idx = enterSignalTable();
+        std::size_t copied = 0;
+        const SignalSafeTable &table = signalTables[idx];
+        if (slot < table.count && capacity > 0)
+        {
+            copied = table.lengths[slot] < capacity - 1 ? table.lengths[slot] : capacity - 1;
+            for (std::size_t i = 0; i < copied; ++i)
+                out[i] = table.values[slot][i];
+        }
+        if (capacity > 0)
+            out[copied] = '\0';
+
+        leaveSignalTable(idx);
+        return copied;
+    }
+
+    /**
+     * @brief Looks up the slot of a registered key. Async-signal-safe.
+     * @param key NUL-terminated translation key.
+     * @return Slot index, or -1 if the key is not registered.
+     */
+    [[nodiscard]] static int findSignalSafeSlot(const char *key) noexcept
+    {
+        unsigned idx = enterSignalTable();
+        int found = -1;
+        const SignalSafeTable &table = signalTables[idx];
+        for (std::size_t i = 0; i < table.count && found < 0; ++i)
+        {
+            const char *a = table.keys[i];
+            const char *b = key;
+            while (*a && *a == *b)
+                ++a, ++b;
+            if (*a == *b)
+                found = static_cast<int>(i);
+        }
+        leaveSignalTable(idx);
+        return found;
+    }
+
+    /**
+     * @brief Enables or disables debug mode.
+     * @param debugMode true to enable, false to disable.
+     */
+    static void setDebugMode(bool debugMode) noexcept
+    {
+        LOC_WRITE_LOCK
+        debugOptions.enabled = debugMode;
+    }
+
+    /**
+     * @brief Checks whether debug mode is active.
+     * @return true if enabled.
+     */
+    [[nodiscard]] static bool isDebugModeOn() noexcept
+    {
+        LOC_READ_LOCK
+        return debugOptions.enabled;
+    }
+
+    /**
+     * @brief Sets the debug output configuration.
+     * @param options DebugOptions structure.
+     */
+    static void setDebugOptions(const DebugOptions &options)
+    {
+        LOC_WRITE_LOCK
+        debugOptions = options;
+    }
+
+    /**
+     * @brief Retrieves modifiable debug options reference.
+     * @return Reference to DebugOptions.
+     */
+    [[nodiscard]] static DebugOptions &getDebugOptions()
+    {
+        LOC_WRITE_LOCK
+        return debugOptions;
+    }
+
+    /**
+     * @brief Retrieves const reference to current debug options.
+     * @return Const reference to DebugOptions.
+     */
+    [[nodiscard]] static const DebugOptions &getDebugOptionsConst() noexcept
+    {
+        LOC_READ_LOCK
+        return debugOptions;
+    }
+
+    /**
+     * @brief Prints summary statistics of loaded languages.
+     */
+    static void printStats()
+    {
+        LOC_READ_LOCK
+        std::size_t count = catalog ? catalog->locales.size() : 0;
+        std::cout << "📦 LocalizeController loaded " << count << " languages:\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t keys = catalog->tables[i].size();
+            if (const ExternalSources *external = catalog->tables[i].external())
+                for (const MoFile *mo : *external)
+                    keys += mo->size();
+            std::cout << "  🌐 " << catalog->locales[i] << " -> " << keys << " keys\n";
+        }
+    }
+};
+
+// ============================================================================
+// CatalogPin
+// ============================================================================
+
+#if defined(_WIN32)
+/// Scatter-gather segment with the layout of POSIX `struct iovec`.
+struct LocIoVec
+{
+    void *iov_base;      ///< Segment start.
+    std::size_t iov_len; ///< Segment length.
+};
+#else
+/// Scatter-gather segment; directly usable with `writev`.
+using LocIoVec = ::iovec;
+#endif
+
+/**
+ * @class CatalogPin
+ * @brief Keeps one catalog generation alive and resolves keys against it.
+ *
+ * @details
+ * Views and segments produced against a pin point into that generation's
+ * memory and stay valid for as long as the pin (or a copy of it) lives,
+ * whatever reloads happen meanwhile. Lookups take no lock.
+ */
+class CatalogPin
+{
+private:
+    std::shared_ptr<const Localizer::Catalog> catalog;           ///< Pinned generation.
+    Localizer::LocaleId current = Localizer::DEFAULT_LOCALE_ID;  ///< Current locale when pinned.
+
+public:
+    CatalogPin() = default;
+
+    /// @internal Used by Localizer::pin().
+    CatalogPin(std::shared_ptr<const Localizer::Catalog> catalog, Localizer::LocaleId current)
+        : catalog(std::move(catalog)), current(current) {}
+
+    [[nodiscard]] explicit operator bool() const noexcept { return catalog != nullptr; }
+
+    /**
+     * @brief Returns the pinned generation number.
+     * @return Generation, 0 for an empty pin.
+     */
+    [[nodiscard]] std::uint64_t generation() const noexcept { return catalog ? catalog->generation : 0; }
+
+    /**
+     * @brief Returns the locale that was current when the pin was taken.
+     * @details Read under the same lock as the generation, so the two always belong together.
+     * @return Locale id.
+     */
+    [[nodiscard]] Localizer::LocaleId localeId() const noexcept { return current; }
+
+    /**
+     * @brief Looks up a key, falling back to the default locale.
+     * @param locale Language code.
+     * @param key Translation key.
+     * @param hash Localizer::hashKey(key), if already known.
+     * @return Value (valid while the pin lives) or std::nullopt.
+     */
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view locale, std::string_view key,
+                                                       std::uint64_t hash) const noexcept
+    {
+        if (!catalog)
+            return std::nullopt;
+        for (const Localizer::Catalog::Table *table : {catalog->table(locale), catalog->table(Localizer::DEFAULT_LOCALE_ID)})
+            if (table)
+                if (auto value = table->find(key, hash))
+                    return value;
+        return std::nullopt;
+    }
+
+    /// @copydoc find(std::string_view, std::string_view, std::uint64_t) const
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view locale, std::string_view key) const noexcept
+    {
+        return find(locale, key, Localizer::hashKey(key));
+    }
+
+    /**
+     * @brief Looks up a key with its precomputed display metrics.
+     * @param locale Language code or Localizer::LocaleId.
+     * @param key Translation key.
+     * @return Value and metrics (valid while the pin lives) or std::nullopt.
+     */
+    template <class Locale>
+    [[nodiscard]] std::optional<MeasuredText> findMeasured(const Locale &locale, std::string_view key) const
+    {
+        if (!catalog)
+            return std::nullopt;
+        std::uint64_t hash = Localizer::hashKey(key);
+        for (const Localizer::Catalog::Table *table : {catalog->table(locale), catalog->table(Localizer::DEFAULT_LOCALE_ID)})
+            if (table)
+                if (auto value = table->findMeasured(key, hash))
+                    return value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Looks up a key as cached UTF-16, falling back to the default locale.
+     * @param locale Language code.
+     * @param key Translation key.
+     * @return Encoded value (valid while the pin lives) or std::nullopt.
+     */
+    [[nodiscard]] std::optional<std::u16string_view> findU16(std::string_view locale, std::string_view key) const
+    {
+        if (auto value = find(locale, key))
+            return catalog->encoded<char16_t>(*value);
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Looks up a key as cached UTF-32, falling back to the default locale.
+     * @param locale Language code.
+     * @param key Translation key.
+     * @return Encoded value (valid while the pin lives) or std::nullopt.
+     */
+    [[nodiscard]] std::optional<std::u32string_view> findU32(std::string_view locale, std::string_view key) const
+    {
+        if (auto value = find(locale, key))
+            return catalog->encoded<char32_t>(*value);
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Looks up one variant of a key, falling back to the default locale.
+     * @param locale Language code or Localizer::LocaleId.
+     * @param key Translation key.
+     * @param variant Variant index; out of range, or a key without variants, yields the plain value.
+     * @return Value (valid while the pin lives) or std::nullopt.
+     */
+    template <class Locale>
+    [[nodiscard]] std::optional<std::string_view> findVariant(const Locale &locale, std::string_view key,
+                                                              std::size_t variant) const
+    {
+        if (!catalog)
+            return std::nullopt;
+        if (const LocValue *set = catalog->resolveVariants(locale, key))
+            return Localizer::selectVariant(*set, Localizer::VariantPick{variant, false});
+        for (const Localizer::Catalog::Table *table : {catalog->table(locale), catalog->table(Localizer::DEFAULT_LOCALE_ID)})
+            if (table)
+                if (auto value = table->find(key))
+                    return value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Looks up a typed (number, boolean or array) leaf, falling back to the default locale.
+     * @param locale Language code or Localizer::LocaleId.
+     * @param key Translation key.
+     * @return Value (valid while the pin lives) or nullptr.
+     */
+    template <class Locale>
+    [[nodiscard]] const LocValue *findValue(const Locale &locale, std::string_view key) const
+    {
+        return catalog ? catalog->resolveTyped(locale, key) : nullptr;
+    }
+};
+
+inline CatalogPin Localizer::pin()
+{
+    LOC_READ_LOCK
+    return CatalogPin(catalog, currentLocaleId);
+}
+
+// ============================================================================
+// LocalizedString
+// ============================================================================
+
+/**
+ * @struct LocaleRenderSet
+ * @brief One message rendered in several locales, stored in a single buffer.
+ */
+struct LocaleRenderSet
+{
+    /// Offsets into `buffer` of one locale's result.
+    struct Entry
+    {
+        std::uint32_t localeOffset; ///< Locale name offset.
+        std::uint32_t localeLength; ///< Locale name length.
+        std::uint32_t textOffset;   ///< Rendered text offset.
+        std::uint32_t textLength;   ///< Rendered text length.
+    };
+
+    std::string buffer;         ///< Locale names and rendered texts, back to back.
+    std::vector<Entry> entries; ///< One entry per locale, in request order.
+
+    [[nodiscard]] std::size_t size() const noexcept { return entries.size(); }
+
+    [[nodiscard]] std::string_view locale(std::size_t i) const noexcept
+    {
+        return std::string_view(buffer).substr(entries[i].localeOffset, entries[i].localeLength);
+    }
+
+    [[nodiscard]] std::string_view text(std::size_t i) const noexcept
+    {
+        return std::string_view(buffer).substr(entries[i].textOffset, entries[i].textLength);
+    }
+
+    /**
+     * @brief Returns the text rendered for a locale.
+     * @param name Language code.
+     * @return Text or std::nullopt if the locale was not rendered.
+     */
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view name) const noexcept
+    {
+        for (std::size_t i = 0; i < entries.size(); ++i)
+            if (locale(i) == name)
+                return text(i);
+        return std::nullopt;
+    }
+};
+
+class DeferredMessage;
+
+/**
+ * @class LocalizedString
+ * @brief Represents a localized string with optional placeholder substitution.
+ */
+class LocalizedString
+{
+    friend class DeferredMessage;
+
+private:
+    std::string key;                                     ///< Localization key.
+    std::unordered_map<std::string, std::string> params; ///< Placeholder substitutions.
+
+    /**
+     * @brief Applies placeholder substitutions on the text.
+     * @tparam String Result string type (`std::string` or `std::pmr::string`).
+     * @param text Original text with placeholders.
+     * @param params Map of placeholder → value pairs.
+     * @param alloc Allocator for the result.
+     * @return Text with replaced placeholders.
+     */
+    template <class String = std::string>
+    static String applyPlaceholders(const String &text,
+                                    const std::unordered_map<std::string, std::string> &params,
+                                    const typename String::allocator_type &alloc = {})
+    {
+#if LOC_USE_REGEX
+        std::string result(text.data(), text.size());
+        for (const auto &[name, value] : params)
+        {
+            std::regex pattern("\\{" + name + "\\}");
+            result = std::regex_replace(result, pattern, value);
+        }
+        return String(result.data(), result.size(), alloc);
+#else
+        String result(alloc);
+        result.reserve(text.size() + 32);
+        expandPlaceholders(std::string_view(text.data(), text.size()), paramLookup(params),
+                           [&result](std::string_view part) { result.append(part); });
+        return result;
+#endif
+    }
+
+    /**
+     * @brief Looks up a placeholder value.
+     * @details Typical maps hold a handful of parameters and are scanned
+     * comparing views, without building a key. Larger maps are hashed; the
+     * probe key only allocates for names longer than the small-string buffer.
+     * @param params Map of placeholder → value pairs.
+     * @param name Placeholder name.
+     * @return Pointer to the value or nullptr.
+     */
+    static const std::string *findParam(const std::unordered_map<std::string, std::string> &params,
+                                        std::string_view name)
+    {
+        if (params.size() <= 8)
+        {
+            for (const auto &[param, value] : params)
+                if (param == name)
+                    return &value;
+            return nullptr;
+        }
+        auto it = params.find(std::string(name));
+        return it != params.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Adapts a parameter map to the lookup interface of expandPlaceholders().
+     * @param params Map of placeholder → value pairs.
+     * @return Lookup callable.
+     */
+    static auto paramLookup(const std::unordered_map<std::string, std::string> &params)
+    {
+        return [&params](std::string_view name, auto &&sink)
+        {
+            const std::string *value = findParam(params, name);
+            if (value)
+                sink(std::string_view(*value));
+            return value != nullptr;
+        };
+    }
+
+    /**
+     * @brief Splits text into literal and substituted parts.
+     * @param text Original text with placeholders.
+     * @param lookup Called as `lookup(name, sink)`; passes the value to `sink` and returns true if known.
+     * @param sink Called with every output part, in order.
+     */
+    template <class Lookup, class Sink>
+    static void expandPlaceholders(std::string_view text, Lookup &&lookup, Sink &&sink)
+    {
+        std::size_t pos = 0;
+        while (pos < text.size())
+        {
+            auto open = text.find('{', pos);
+            if (open == std::string_view::npos)
+            {
+                sink(text.substr(pos));
+                break;
+            }
+
+            sink(text.substr(pos, open - pos));
+
+            auto close = text.find('}', open + 1);
+            if (close == std::string_view::npos)
+            {
+                sink(text.substr(open));
+                break;
+            }
+
+            if (!lookup(text.substr(open + 1, close - open - 1), sink))
+                sink(text.substr(open, close - open + 1));
+
+            pos = close + 1;
+        }
+    }
+
+    /**
+     * @struct CompiledTemplate
+     * @brief Translation split into literal and placeholder segments.
+     */
+    struct CompiledTemplate
+    {
+        /// One segment; `placeholder` segments hold the name without braces.
+        struct Segment
+        {
+            std::string_view text;
+            bool placeholder;
+        };
+
+        std::vector<Segment> segments; ///< Segments in output order.
+        std::size_t literalSize = 0;   ///< Total size of the literal segments.
+
+        /**
+         * @brief Splits a translation; unknown-placeholder handling matches expandPlaceholders().
+         * @param text Translation text (must outlive the template).
+         */
+        void compile(std::string_view text)
+        {
+            segments.clear();
+            literalSize = 0;
+            auto literal = [this](std::string_view part)
+            {
+                if (part.empty())
+                    return;
+                segments.push_back({part, false});
+                literalSize += part.size();
+            };
+            expandPlaceholders(text,
+                               [this](std::string_view name, auto &&)
+                               {
+                                   segments.push_back({name, true});
+                                   return true;
+                               },
+                               literal);
+        }
+
+        /**
+         * @brief Makes the template a single literal segment, without placeholder parsing.
+         * @param text Literal text (must outlive the template).
+         */
+        void compileLiteral(std::string_view text)
+        {
+            segments.assign(1, Segment{text, false});
+            literalSize = text.size();
+        }
+
+        /**
+         * @brief Renders the template with parameters into `out` (cleared first).
+         */
+        void render(const std::unordered_map<std::string, std::string> *params, std::string &out) const
+        {
+            out.clear();
+            for (const Segment &segment : segments)
+            {
+                if (!segment.placeholder)
+                {
+                    out.append(segment.text);
+                    continue;
+                }
+                const std::string *value = params ? findParam(*params, segment.text) : nullptr;
+                if (value)
+                    out.append(*value);
+                else
+                    out.append("{").append(segment.text).append("}");
+            }
+        }
+    };
+
+    /**
+     * @brief Renders one key in several locales against a single pinned catalog.
+     *
+     * @details
+     * The key is hashed once and the default-locale fallback resolved once;
+     * every placeholder name is looked up once and its value reused for all
+     * locales.
+     *
+     * @param key Translation key.
+     * @param subset Locales to render, or nullptr / empty for every loaded locale.
+     * @param lookup Parameter lookup as for expandPlaceholders(); values must outlive the call.
+     * @return Rendered texts.
+     */
+    template <class Lookup>
+    static LocaleRenderSet renderLocales(std::string_view key, const std::vector<std::string_view> *subset, Lookup &&lookup)
+    {
+        LocaleRenderSet result;
+        auto pinned = Localizer::pinCatalog();
+        std::uint64_t hash = Localizer::hashKey(key);
+
+        std::vector<std::string_view> locales;
+        if (subset && !subset->empty())
+            locales = *subset;
+        else if (pinned)
+            locales.assign(pinned->locales.begin(), pinned->locales.end());
+
+        const Localizer::Catalog::Table *defaults = pinned ? pinned->table(Localizer::DEFAULT_LOCALE_ID) : nullptr;
+        std::optional<std::string_view> fallback = defaults ? defaults->find(key, hash) : std::nullopt;
+        std::string missing;
+        if (!fallback)
+        {
+            missing.assign("[Missing:").append(key).append("]");
+            fallback = missing;
+        }
+
+        std::vector<std::string_view> values;
+        values.reserve(locales.size());
+        std::size_t estimate = 0;
+        for (std::string_view locale : locales)
+        {
+            const Localizer::Catalog::Table *table = pinned ? pinned->table(locale) : nullptr;
+            std::optional<std::string_view> value = table ? table->find(key, hash) : std::nullopt;
+            values.push_back(value ? *value : *fallback);
+            estimate += locale.size() + values.back().size() + 16;
+        }
+
+        std::vector<std::pair<std::string_view, std::optional<std::string_view>>> resolved;
+        auto cached = [&](std::string_view name, auto &&sink)
+        {
+            for (const auto &[known, value] : resolved)
+            {
+                if (known == name)
+                {
+                    if (value)
+                        sink(*value);
+                    return value.has_value();
+                }
+            }
+            std::optional<std::string_view> value;
+            lookup(name, [&value](std::string_view part) { value = part; });
+            resolved.emplace_back(name, value);
+            if (value)
+                sink(*value);
+            return value.has_value();
+        };
+
+        result.buffer.reserve(estimate);
+        result.entries.reserve(locales.size());
+        for (std::size_t i = 0; i < locales.size(); ++i)
+        {
+            LocaleRenderSet::Entry entry;
+            entry.localeOffset = static_cast<std::uint32_t>(result.buffer.size());
+            entry.localeLength = static_cast<std::uint32_t>(locales[i].size());
+            result.buffer.append(locales[i]);
+            entry.textOffset = static_cast<std::uint32_t>(result.buffer.size());
+            expandPlaceholders(values[i], cached, [&result](std::string_view part) { result.buffer.append(part); });
+            entry.textLength = static_cast<std::uint32_t>(result.buffer.size() - entry.textOffset);
+            result.entries.push_back(entry);
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Renders a key in every loaded locale, or in a chosen subset.
+     *
+     * @details
+     * Unlike calling setLocale() and L() per locale, this takes no write lock
+     * and leaves the current locale alone. Locales without the key fall back
+     * to the default locale.
+     *
+     * @param key Translation key.
+     * @param params Placeholder values.
+     * @param locales Locales to render; empty for all loaded locales.
+     * @return All results in one contiguous buffer with an offset table.
+     */
+    [[nodiscard]] static LocaleRenderSet renderAllLocales(std::string_view key,
+                                                          const std::unordered_map<std::string, std::string> &params = {},
+                                                          const std::vector<std::string_view> &locales = {})
+    {
+        return renderLocales(key, &locales, paramLookup(params));
+    }
+
+    /**
+     * @brief Renders this string in every loaded locale, or in a chosen subset.
+     * @param locales Locales to render; empty for all loaded locales.
+     * @return All results in one contiguous buffer with an offset table.
+     */
+    [[nodiscard]] LocaleRenderSet renderAllLocales(const std::vector<std::string_view> &locales = {}) const
+    {
+        return renderAllLocales(key, params, locales);
+    }
+
+    /**
+     * @struct BulkRecord
+     * @brief One message of a bulk render: locale, key and optional parameters.
+     */
+    struct BulkRecord
+    {
+        std::string_view locale;                                        ///< Target locale.
+        std::string_view key;                                           ///< Translation key.
+        const std::unordered_map<std::string, std::string> *params = nullptr; ///< Parameters or nullptr.
+    };
+
+    /**
+     * @brief Renders many records across a pool of worker threads.
+     *
+     * @details
+     * Records are grouped by (locale, key) so every translation is looked up
+     * and split into segments once per group, against a single pinned catalog
+     * generation, and then reused for all records of the group. Large groups
+     * are cut into chunks of `LOC_BULK_CHUNK_SIZE` records that workers pick
+     * up dynamically.
+     *
+     * `sink(index, text)` is called exactly once per record, concurrently from
+     * the workers and in no particular order; `index` is the position in
+     * `records` and `text` is only valid during the call. Missing keys render
+     * as `[Missing:key]` verbatim; debug decorations are not applied.
+     *
+     * If the sink or rendering throws, the remaining tasks are abandoned, all
+     * workers are joined and the first exception is rethrown to the caller.
+     *
+     * @param records Records to render.
+     * @param count Number of records.
+     * @param sink Thread-safe output callback.
+     * @param workers Number of threads, 0 for `std::thread::hardware_concurrency()`.
+     */
+    template <class Sink>
+    static void renderBulk(const BulkRecord *records, std::size_t count, Sink &&sink, unsigned workers = 0)
+    {
+        if (count == 0)
+            return;
+
+        // Group records by (locale, key): assign group ids through a map keyed
+        // by the view addresses (records of one batch usually share them) that
+        // falls back to comparing text, then counting-sort the indices.
+        struct ViewPair
+        {
+            std::string_view locale, key;
+            bool operator==(const ViewPair &o) const noexcept { return locale == o.locale && key == o.key; }
+        };
+        struct AddressPair
+        {
+            const char *locale, *key;
+            std::size_t localeSize, keySize;
+            bool operator==(const AddressPair &o) const noexcept
+            {
+                return locale == o.locale && key == o.key && localeSize == o.localeSize && keySize == o.keySize;
+            }
+        };
+        struct PairHash
+        {
+            std::size_t operator()(const ViewPair &p) const noexcept
+            {
+                return static_cast<std::size_t>(Localizer::hashKey(p.locale) * 31 + Localizer::hashKey(p.key));
+            }
+            std::size_t operator()(const AddressPair &p) const noexcept
+            {
+                auto h = reinterpret_cast<std::uintptr_t>(p.locale) * 0x9e3779b97f4a7c15ull;
+                h ^= reinterpret_cast<std::uintptr_t>(p.key) + p.keySize + (h << 6) + (h >> 2);
+                return static_cast<std::size_t>(h ^ p.localeSize);
+            }
+        };
+
+        std::unordered_map<AddressPair, std::uint32_t, PairHash> byAddress;
+        std::unordered_map<ViewPair, std::uint32_t, PairHash> byText;
+        std::vector<std::uint32_t> group(count);
+        std::vector<std::size_t> groupStart;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const BulkRecord &r = records[i];
+            AddressPair address{r.locale.data(), r.key.data(), r.locale.size(), r.key.size()};
+            auto it = byAddress.find(address);
+            if (it == byAddress.end())
+            {
+                auto id = static_cast<std::uint32_t>(byText.size());
+                id = byText.emplace(ViewPair{r.locale, r.key}, id).first->second;
+                it = byAddress.emplace(address, id).first;
+                if (id == groupStart.size())
+                    groupStart.push_back(0);
+            }
+            group[i] = it->second;
+            ++groupStart[it->second];
+        }
+
+        std::size_t offset = 0;
+        for (std::size_t &start : groupStart)
+            offset += std::exchange(start, offset);
+
+        std::vector<std::uint32_t> order(count);
+        {
+            std::vector<std::size_t> fill(groupStart);
+            for (std::size_t i = 0; i < count; ++i)
+                order[fill[group[i]]++] = static_cast<std::uint32_t>(i);
+        }
+
+        // Cut into tasks that never span two groups.
+        struct Task
+        {
+            std::size_t begin, end;
+        };
+        std::vector<Task> tasks;
+        for (std::size_t g = 0; g < groupStart.size(); ++g)
+        {
+            std::size_t end = g + 1 < groupStart.size() ? groupStart[g + 1] : count;
+            for (std::size_t begin = groupStart[g]; begin < end; begin += LOC_BULK_CHUNK_SIZE)
+                tasks.push_back({begin, std::min<std::size_t>(begin + LOC_BULK_CHUNK_SIZE, end)});
+        }
+
+        auto pinned = Localizer::pinCatalog();
+        std::atomic<std::size_t> nextTask{0};
+        std::exception_ptr failure;
+        std::once_flag failed;
+
+        auto render = [&]
+        {
+            CompiledTemplate compiled;
+            std::string missing;
+            std::string out;
+            const BulkRecord *current = nullptr;
+
+            for (std::size_t t; (t = nextTask.fetch_add(1, std::memory_order_relaxed)) < tasks.size();)
+            {
+                const BulkRecord &head = records[order[tasks[t].begin]];
+                if (!current || current->locale != head.locale || current->key != head.key)
+                {
+                    std::optional<std::string_view> value;
+                    if (pinned)
+                    {
+                        for (const Localizer::Catalog::Table *table : {pinned->table(head.locale), pinned->table(Localizer::DEFAULT_LOCALE_ID)})
+                            if (table && (value = table->find(head.key)))
+                                break;
+                    }
+                    if (value)
+                    {
+                        compiled.compile(*value);
+                    }
+                    else
+                    {
+                        missing.assign("[Missing:").append(head.key).append("]");
+                        compiled.compileLiteral(missing);
+                    }
+                    current = &head;
+                }
+
+                for (std::size_t i = tasks[t].begin; i < tasks[t].end; ++i)
+                {
+                    compiled.render(records[order[i]].params, out);
+                    sink(static_cast<std::size_t>(order[i]), std::string_view(out));
+                }
+            }
+        };
+        auto work = [&]
+        {
+            try
+            {
+                render();
+            }
+            catch (...)
+            {
+                std::call_once(failed, [&] { failure = std::current_exception(); });
+                nextTask.store(tasks.size(), std::memory_order_relaxed);
+            }
+        };
+
+        if (workers == 0)
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = static_cast<unsigned>(std::min<std::size_t>(workers, tasks.size()));
+
+        struct JoinAll
+        {
+            std::vector<std::thread> &pool;
+            ~JoinAll()
+            {
+                for (auto &thread : pool)
+                    thread.join();
+            }
+        };
+        std::vector<std::thread> pool;
+        {
+            JoinAll joiner{pool};
+            try
+            {
+                pool.reserve(workers - 1);
+                for (unsigned i = 1; i < workers; ++i)
+                    pool.emplace_back(work);
+            }
+            catch (...)
+            {
+                // Could not start every worker: stop the ones that did start.
+                nextTask.store(tasks.size(), std::memory_order_relaxed);
+                throw;
+            }
+            work();
+        }
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+    /**
+     * @brief Renders many records across a pool of worker threads.
+     * @see renderBulk(const BulkRecord *, std::size_t, Sink &&, unsigned)
+     */
+    template <class Sink>
+    static void renderBulk(const std::vector<BulkRecord> &records, Sink &&sink, unsigned workers = 0)
+    {
+        renderBulk(records.data(), records.size(), std::forward<Sink>(sink), workers);
+    }
+
+    /**
+     * @brief Constructs a localized string without parameters.
+     * @param key Translation key.
+     */
+    explicit LocalizedString(std::string key) : key(std::move(key)) {}
+
+    /**
+     * @brief Constructs a localized string with parameters.
+     * @param key Translation key.
+     * @param params Map of placeholder values.
+     */
+    LocalizedString(std::string key, std::unordered_map<std::string, std::string> params)
+        : key(std::move(key)), params(std::move(params)) {}
+
+    /**
+     * @brief Retrieves the resolved localized string.
+     * @return Localized text with substituted parameters.
+     */
+    [[nodiscard]] std::string str() const
+    {
+        std::string base = Localizer::translate(key);
+        return params.empty() ? base : applyPlaceholders(base, params);
+    }
+
+    /**
+     * @brief Retrieves the resolved localized string, allocated from a memory resource.
+     * @param resource Resource for the lookup result and the formatted text.
+     * @return Localized text with substituted parameters.
+     */
+    [[nodiscard]] std::pmr::string str(std::pmr::memory_resource *resource) const
+    {
+        std::pmr::string base = Localizer::translate(key, resource);
+        return params.empty() ? base : applyPlaceholders(base, params, std::pmr::polymorphic_allocator<char>(resource));
+    }
+
+    /**
+     * @brief Renders into a frame arena without touching the global heap.
+     *
+     * @details
+     * The value is resolved through the realtime view, like
+     * Localizer::translateRealtime(), so no lock is taken, measured and then
+     * formatted straight into one arena allocation; a missing key yields the
+     * `[Missing:key]` marker. The view is valid until the next
+     * `arena.reset()`; see FrameView for the debug checks. Debug decorations
+     * are not applied, and placeholders are always expanded by the non-regex
+     * parser.
+     *
+     * @param arena Frame arena receiving the text.
+     * @return View of the rendered text.
+     */
+    [[nodiscard]] FrameView render(FrameArena &arena) const
+    {
+        return Localizer::withRealtimeValue(key, [this, &arena](std::optional<std::string_view> value)
+        {
+            if (!value)
+            {
+                static constexpr std::string_view missingOpen = "[Missing:";
+                std::size_t length = missingOpen.size() + key.size() + 1;
+                char *out = arena.allocate(length);
+                std::memcpy(out, missingOpen.data(), missingOpen.size());
+                std::memcpy(out + missingOpen.size(), key.data(), key.size());
+                out[length - 1] = ']';
+                return FrameView(arena, out, length);
+            }
+            if (params.empty())
+            {
+                char *out = arena.allocate(value->size());
+                if (!value->empty())
+                    std::memcpy(out, value->data(), value->size());
+                return FrameView(arena, out, value->size());
+            }
+
+            std::size_t length = 0;
+            expandPlaceholders(*value, paramLookup(params), [&length](std::string_view part) { length += part.size(); });
+
+            char *out = arena.allocate(length);
+            std::size_t written = 0;
+            expandPlaceholders(*value, paramLookup(params), [out, &written](std::string_view part)
+            {
+                if (!part.empty())
+                    std::memcpy(out + written, part.data(), part.size());
+                written += part.size();
+            });
+            return FrameView(arena, out, length);
+        });
+    }
+
+    /**
+     * @brief Returns the display metrics of the rendered text in the current locale.
+     *
+     * @details
+     * Starts from the metrics precomputed for the translation and only
+     * measures the substituted parameter values, so nothing is rendered.
+     * Clusters are not merged across a placeholder boundary. Debug
+     * decorations are not included.
+     *
+     * @return Metrics of str() without decorations.
+     */
+    [[nodiscard]] TextMetrics metrics() const
+    {
+        CatalogPin pinned = Localizer::pin();
+        std::optional<MeasuredText> value = pinned.findMeasured(pinned.localeId(), key);
+        if (!value)
+            return Localizer::missingMetrics(key);
+
+        TextMetrics result = value->metrics;
+        if (params.empty())
+            return result;
+        expandPlaceholders(value->text, [this, &result](std::string_view name, auto &&)
+        {
+            const std::string *param = findParam(params, name);
+            if (param)
+            {
+                result -= Localizer::measureText(std::string_view(name.data() - 1, name.size() + 2));
+                result += Localizer::measureText(*param);
+            }
+            return param != nullptr;
+        },
+        [](std::string_view) {});
+        return result;
+    }
+
+    /**
+     * @brief Renders as scatter-gather segments without copying any text.
+     *
+     * @details
+     * Segments reference the pinned catalog and this object's parameter
+     * values; they stay valid while the pin lives and this object is neither
+     * modified nor destroyed, and can be passed to `writev` directly.
+     * Segments are appended to `out`. Debug decorations are not applied.
+     *
+     * @param pin Catalog generation to resolve against.
+     * @param locale Language code (falls back to the default locale).
+     * @param out Receives the segments.
+     */
+    void renderSegments(const CatalogPin &pin, std::string_view locale, std::vector<LocIoVec> &out) const
+    {
+        static constexpr std::string_view missingOpen = "[Missing:";
+        static constexpr std::string_view missingClose = "]";
+
+        auto push = [&out](std::string_view part)
+        {
+            if (part.empty())
+                return;
+            LocIoVec v;
+            v.iov_base = const_cast<char *>(part.data());
+            v.iov_len = part.size();
+            out.push_back(v);
+        };
+
+        auto value = pin.find(locale, key);
+        if (!value)
+        {
+            push(missingOpen);
+            push(key);
+            push(missingClose);
+            return;
+        }
+        if (params.empty())
+            push(*value);
+        else
+            expandPlaceholders(*value, paramLookup(params), push);
+    }
+
+    /**
+     * @brief Renders as scatter-gather segments in the locale that was current when `pin` was taken.
+     * @param pin Catalog generation to resolve against.
+     * @param out Receives the segments.
+     */
+    void renderSegments(const CatalogPin &pin, std::vector<LocIoVec> &out) const
+    {
+        renderSegments(pin, Localizer::localeName(pin.localeId()), out);
+    }
+
+    /**
+     * @brief Serializes the key and parameters for another process to render.
+     * @return Binary message, see DeferredMessage::serialize().
+     */
+    [[nodiscard]] std::string serialize() const;
+
+    /**
+     * @brief Reconstructs a localized string from DeferredMessage::serialize() output.
+     * @param bytes Binary message.
+     * @param catalogMatches Optional; receives whether the sender's catalog fingerprint matches ours.
+     * @return Localized string, or std::nullopt if the message cannot be decoded.
+     */
+    [[nodiscard]] static std::optional<LocalizedString> deserialize(std::string_view bytes, bool *catalogMatches = nullptr);
+
+    /**
+     * @brief Implicit conversion to std::string.
+     */
+    [[nodiscard]] operator std::string() const { return str(); }
+
+    /**
+     * @brief Stream output operator.
+     * @param os Output stream.
+     * @param s LocalizedString instance.
+     * @return Reference to output stream.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const LocalizedString &s)
+    {
+        return os << s.str();
+    }
+};
+
+// ============================================================================
+// DeferredMessage
+// ============================================================================
+
+/**
+ * @class DeferredMessage
+ * @brief Key id plus typed arguments captured by value, rendered only on demand.
+ *
+ * @details
+ * Meant for structured logging: constructing a message interns the key and
+ * copies the arguments into a small inline buffer, but performs no lookup
+ * and no formatting. A record dropped by level or sampling therefore never
+ * pays for localization. render() may run later, on another thread and in
+ * another locale.
+ *
+ * At most `LOC_DEFERRED_MAX_ARGS` arguments are kept; further ones are
+ * dropped and reported through the error callback (code 3). Names and
+ * string values share `LOC_DEFERRED_INLINE_SIZE` inline bytes before
+ * spilling to the heap.
+ */
+class DeferredMessage
+{
+    friend class LocalizedString;
+
+public:
+    /// Argument value type.
+    enum class ArgType : std::uint8_t
+    {
+        Int,
+        UInt,
+        Double,
+        Bool,
+        String
+    };
+
+    /**
+     * @struct Arg
+     * @brief Transient argument description used at construction.
+     */
+    struct Arg
+    {
+        std::string_view name; ///< Placeholder name.
+        ArgType type;          ///< Value type.
+        union
+        {
+            std::int64_t i;
+            std::uint64_t u; ///< Also holds ArgType::Bool as 0 / 1.
+            double d;
+        };
+        std::string_view text; ///< String value (ArgType::String).
+
+        template <class T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T> && !std::is_same_v<T, bool>, int> = 0>
+        Arg(std::string_view name, T value) : name(name), type(ArgType::Int), i(value) {}
+
+        template <class T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>, int> = 0>
+        Arg(std::string_view name, T value) : name(name), type(ArgType::UInt), u(value) {}
+
+        Arg(std::string_view name, double value) : name(name), type(ArgType::Double), d(value) {}
+        Arg(std::string_view name, bool value) : name(name), type(ArgType::Bool), u(value ? 1 : 0) {}
+        Arg(std::string_view name, std::string_view value) : name(name), type(ArgType::String), i(0), text(value) {}
+        Arg(std::string_view name, const char *value) : Arg(name, std::string_view(value)) {}
+        Arg(std::string_view name, const std::string &value) : Arg(name, std::string_view(value)) {}
+
+        /**
+         * @brief Returns the bit pattern of a non-string value, read through the active member.
+         */
+        [[nodiscard]] std::uint64_t bits() const noexcept
+        {
+            switch (type)
+            {
+            case ArgType::Int:
+                return static_cast<std::uint64_t>(i);
+            case ArgType::Double:
+            {
+                std::uint64_t raw;
+                std::memcpy(&raw, &d, sizeof(raw));
+                return raw;
+            }
+            case ArgType::UInt:
+            case ArgType::Bool:
+                return u;
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Stores a bit pattern from bits() into the member selected by `type`.
+         */
+        void setBits(std::uint64_t raw) noexcept
+        {
+            switch (type)
+            {
+            case ArgType::Int:
+                i = static_cast<std::int64_t>(raw);
+                break;
+            case ArgType::Double:
+            {
+                double value;
+                std::memcpy(&value, &raw, sizeof(value));
+                d = value;
+                break;
+            }
+            default:
+                u = raw;
+            }
+        }
+    };
+
+private:
+    /**
+     * @struct Slot
+     * @brief Stored argument; text lives in the message's text buffer.
+     */
+    struct Slot
+    {
+        std::uint32_t nameOffset = 0;
+        std::uint32_t nameLength = 0;
+        std::uint32_t textOffset = 0;
+        std::uint32_t textLength = 0;
+        ArgType type = ArgType::Int;
+        std::uint64_t bits = 0; ///< Value bits from Arg::bits().
+    };
+
+    Localizer::KeyId key = 0;                       ///< Interned key.
+    std::uint8_t count = 0;                         ///< Number of stored arguments.
+    std::uint32_t textUsed = 0;                     ///< Bytes used in the text buffer.
+    Slot slots[LOC_DEFERRED_MAX_ARGS];              ///< Stored arguments.
+    char inlineText[LOC_DEFERRED_INLINE_SIZE];      ///< Inline text storage.
+    std::string spill;                              ///< Text storage when the inline buffer is too small.
+
+    [[nodiscard]] const char *textBase() const noexcept
+    {
+        return spill.empty() ? inlineText : spill.data();
+    }
+
+    template <class Range>
+    void capture(const Range &args)
+    {
+        if (args.size() > LOC_DEFERRED_MAX_ARGS)
+            LOC_RAISE_ERROR("DeferredMessage keeps " + std::to_string(LOC_DEFERRED_MAX_ARGS) +
+                                " arguments, the rest are dropped: " + std::string(Localizer::keyName(key)),
+                            3);
+
+        std::size_t needed = 0;
+        for (const Arg &arg : args)
+            needed += arg.name.size() + (arg.type == ArgType::String ? arg.text.size() : 0);
+        char *out = inlineText;
+        if (needed > sizeof(inlineText))
+        {
+            spill.resize(needed);
+            out = spill.data();
+        }
+
+        auto append = [&](std::string_view text)
+        {
+            if (!text.empty())
+                std::memcpy(out + textUsed, text.data(), text.size());
+            textUsed += static_cast<std::uint32_t>(text.size());
+        };
+
+        for (const Arg &arg : args)
+        {
+            if (count == LOC_DEFERRED_MAX_ARGS)
+                break;
+            Slot &slot = slots[count++];
+            slot.type = arg.type;
+            slot.nameOffset = textUsed;
+            slot.nameLength = static_cast<std::uint32_t>(arg.name.size());
+            append(arg.name);
+            if (arg.type == ArgType::String)
+            {
+                slot.textOffset = textUsed;
+                slot.textLength = static_cast<std::uint32_t>(arg.text.size());
+                append(arg.text);
+            }
+            else
+            {
+                slot.bits = arg.bits();
+            }
+        }
+    }
+
+    /**
+     * @brief Formats one argument and passes the text to a sink.
+     */
+    template <class Sink>
+    void emit(const Slot &slot, Sink &&sink) const
+    {
+        Arg arg("", std::uint64_t(0));
+        arg.type = slot.type;
+        arg.setBits(slot.bits);
+        if (slot.type == ArgType::String)
+            arg.text = std::string_view(textBase() + slot.textOffset, slot.textLength);
+        emitArg(arg, sink);
+    }
+
+    /**
+     * @brief Formats an argument value and passes the text to a sink.
+     */
+    template <class Sink>
+    static void emitArg(const Arg &arg, Sink &&sink)
+    {
+        char buffer[32];
+        std::to_chars_result res{buffer, std::errc()};
+        switch (arg.type)
+        {
+        case ArgType::Int:
+            res = std::to_chars(buffer, buffer + sizeof(buffer), arg.i);
+            break;
+        case ArgType::UInt:
+            res = std::to_chars(buffer, buffer + sizeof(buffer), arg.u);
+            break;
+        case ArgType::Double:
+            res = std::to_chars(buffer, buffer + sizeof(buffer), arg.d);
+            break;
+        case ArgType::Bool:
+            sink(std::string_view(arg.u ? "true" : "false"));
+            return;
+        case ArgType::String:
+            sink(arg.text);
+            return;
+        }
+        sink(std::string_view(buffer, static_cast<std::size_t>(res.ptr - buffer)));
+    }
+
+    // --- Wire format -------------------------------------------------------------------
+    //
+    //   "LM" version:u8 fingerprint:u64 keyHash:u64 argc:varint
+    //   argc × { nameRef:varint [len:varint name] type:u8 value }
+    //
+    // Fixed-width integers are little-endian. nameRef 0 is followed by the
+    // literal name; nameRef n > 0 is the (n-1)-th entry of the sorted,
+    // de-duplicated placeholder names of the key's default-locale value, which
+    // both sides know as long as their fingerprints match. Values: Int is a
+    // zigzag varint, UInt a varint, Double 8 bytes, Bool 1 byte, String a
+    // varint length plus bytes.
+
+    static constexpr unsigned char WIRE_VERSION = 1;
+
+    static void putVarint(std::string &out, std::uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    static void putFixed64(std::string &out, std::uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i)
+            out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+
+    /**
+     * @struct WireReader
+     * @brief Bounds-checked cursor over a serialized message.
      */
-    static void setDebugMode(bool debugMode) noexcept
+    struct WireReader
     {
-        LOC_WRITE_LOCK
-        debugOptions.enabled = debugMode;
+        std::string_view bytes;
+        std::size_t pos = 0;
+        bool ok = true;
+
+        std::uint64_t varint()
+        {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos >= bytes.size())
+                    break;
+                auto c = static_cast<unsigned char>(bytes[pos++]);
+                v |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+                if (!(c & 0x80))
+                    return v;
+            }
+            ok = false;
+            return 0;
+        }
+
+        std::uint64_t fixed64()
+        {
+            if (bytes.size() - pos < 8)
+            {
+                ok = false;
+                return 0;
+            }
+            std::uint64_t v = 0;
+            for (int i = 0; i < 8; ++i)
+                v |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[pos++])) << (8 * i);
+            return v;
+        }
+
+        unsigned char byte()
+        {
+            if (pos >= bytes.size())
+            {
+                ok = false;
+                return 0;
+            }
+            return static_cast<unsigned char>(bytes[pos++]);
+        }
+
+        std::string_view text()
+        {
+            std::uint64_t length = varint();
+            if (!ok || length > bytes.size() - pos)
+            {
+                ok = false;
+                return {};
+            }
+            std::string_view result = bytes.substr(pos, static_cast<std::size_t>(length));
+            pos += static_cast<std::size_t>(length);
+            return result;
+        }
+    };
+
+    /**
+     * @brief Collects the sorted, unique placeholder names of a key's default-locale value.
+     * @param pinned Catalog the names are taken from (views stay valid while it lives).
+     * @param key Translation key.
+     * @param names Output vector.
+     */
+    static void wireNames(const Localizer::Catalog *pinned, std::string_view key, std::vector<std::string_view> &names)
+    {
+        names.clear();
+        const Localizer::Catalog::Table *defaults = pinned ? pinned->table(Localizer::DEFAULT_LOCALE_ID) : nullptr;
+        auto value = defaults ? defaults->find(key) : std::nullopt;
+        if (!value)
+            return;
+        Localizer::forEachPlaceholder(*value, [&names](std::string_view name) { names.push_back(name); });
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
     }
 
     /**
-     * @brief Checks whether debug mode is active.
-     * @return true if enabled.
+     * @brief Encodes a key and arguments against the current catalog.
+     * @param key Translation key.
+     * @param args Arguments.
+     * @return Binary message.
      */
-    [[nodiscard]] static bool isDebugModeOn() noexcept
+    template <class Range>
+    static std::string encode(std::string_view key, const Range &args)
     {
-        LOC_READ_LOCK
-        return debugOptions.enabled;
+        auto pinned = Localizer::pinCatalog();
+        std::vector<std::string_view> names;
+        wireNames(pinned.get(), key, names);
+
+        std::string out;
+        out.reserve(20 + key.size());
+        out.append("LM").push_back(static_cast<char>(WIRE_VERSION));
+        putFixed64(out, pinned ? pinned->fingerprint : 0);
+        putFixed64(out, Localizer::hashKey(key));
+
+        std::size_t argc = 0;
+        for ([[maybe_unused]] const Arg &arg : args)
+            ++argc;
+        putVarint(out, argc);
+
+        for (const Arg &arg : args)
+        {
+            auto it = std::lower_bound(names.begin(), names.end(), arg.name);
+            if (it != names.end() && *it == arg.name)
+            {
+                putVarint(out, static_cast<std::uint64_t>(it - names.begin()) + 1);
+            }
+            else
+            {
+                putVarint(out, 0);
+                putVarint(out, arg.name.size());
+                out.append(arg.name);
+            }
+
+            out.push_back(static_cast<char>(arg.type));
+            switch (arg.type)
+            {
+            case ArgType::Int:
+                putVarint(out, (static_cast<std::uint64_t>(arg.i) << 1) ^ static_cast<std::uint64_t>(arg.i >> 63));
+                break;
+            case ArgType::UInt:
+                putVarint(out, arg.u);
+                break;
+            case ArgType::Double:
+                putFixed64(out, arg.bits());
+                break;
+            case ArgType::Bool:
+                out.push_back(static_cast<char>(arg.u ? 1 : 0));
+                break;
+            case ArgType::String:
+                putVarint(out, arg.text.size());
+                out.append(arg.text);
+                break;
+            }
+        }
+        return out;
     }
 
     /**
-     * @brief Sets the debug output configuration.
-     * @param options DebugOptions structure.
+     * @brief Decodes a binary message against the current catalog.
+     *
+     * @details
+     * When the fingerprints differ, messages are still decoded as long as
+     * the key exists here and every argument name is spelled out; name
+     * references into the sender's catalog are rejected.
+     *
+     * @param bytes Binary message.
+     * @param catalogMatches Optional; receives whether the fingerprints match.
+     *        If null, a mismatch is also reported through the error callback.
+     * @param onKey Called with the resolved key.
+     * @param onArg Called with every decoded argument.
+     * @return true on success.
      */
-    static void setDebugOptions(const DebugOptions &options)
+    template <class OnKey, class OnArg>
+    static bool decode(std::string_view bytes, bool *catalogMatches, OnKey &&onKey, OnArg &&onArg)
     {
-        LOC_WRITE_LOCK
-        debugOptions = options;
+        Localizer::ErrorFlush flush;
+        auto pinned = Localizer::pinCatalog();
+        WireReader in{bytes};
+
+        if (bytes.substr(0, 2) != "LM" || bytes.size() < 3 || static_cast<unsigned char>(bytes[2]) != WIRE_VERSION)
+        {
+            LOC_RAISE_ERROR("Malformed localized message", 5);
+            return false;
+        }
+        in.pos = 3;
+        std::uint64_t fingerprint = in.fixed64();
+        std::uint64_t keyHash = in.fixed64();
+        if (!in.ok)
+        {
+            LOC_RAISE_ERROR("Malformed localized message", 5);
+            return false;
+        }
+
+        bool matches = pinned && pinned->fingerprint == fingerprint;
+        if (catalogMatches)
+            *catalogMatches = matches;
+        else if (!matches)
+            LOC_RAISE_ERROR("Localized message was encoded against a different catalog", 4);
+
+        auto key = pinned ? pinned->keyForHash(keyHash) : std::nullopt;
+        if (!key)
+        {
+            LOC_RAISE_ERROR("Localized message refers to an unknown key", 5);
+            return false;
+        }
+
+        std::vector<std::string_view> names;
+        wireNames(pinned.get(), *key, names);
+        onKey(*key);
+
+        std::uint64_t argc = in.varint();
+        for (std::uint64_t i = 0; in.ok && i < argc; ++i)
+        {
+            std::uint64_t ref = in.varint();
+            std::string_view name;
+            if (ref == 0)
+                name = in.text();
+            else if (matches && ref <= names.size())
+                name = names[static_cast<std::size_t>(ref - 1)];
+            else
+                in.ok = false;
+
+            auto type = static_cast<ArgType>(in.byte());
+            Arg arg(name, std::uint64_t(0));
+            arg.type = type;
+            switch (type)
+            {
+            case ArgType::Int:
+            {
+                std::uint64_t z = in.varint();
+                arg.i = static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+                break;
+            }
+            case ArgType::UInt:
+                arg.u = in.varint();
+                break;
+            case ArgType::Double:
+                arg.setBits(in.fixed64());
+                break;
+            case ArgType::Bool:
+                arg.u = in.byte() ? 1 : 0;
+                break;
+            case ArgType::String:
+                arg.text = in.text();
+                break;
+            default:
+                in.ok = false;
+            }
+            if (in.ok)
+                onArg(arg);
+        }
+
+        if (!in.ok || in.pos != bytes.size())
+        {
+            LOC_RAISE_ERROR("Malformed localized message", 5);
+            return false;
+        }
+        return true;
+    }
+
+    std::string format(const LocString &value) const
+    {
+        std::string result;
+        result.reserve(value.size() + 16);
+        LocalizedString::expandPlaceholders(
+            value.view(),
+            [this](std::string_view name, auto &&sink)
+            {
+                for (std::uint8_t i = 0; i < count; ++i)
+                {
+                    if (std::string_view(textBase() + slots[i].nameOffset, slots[i].nameLength) == name)
+                    {
+                        emit(slots[i], sink);
+                        return true;
+                    }
+                }
+                return false;
+            },
+            [&result](std::string_view part) { result.append(part); });
+        return result;
     }
 
+public:
     /**
-     * @brief Retrieves modifiable debug options reference.
-     * @return Reference to DebugOptions.
+     * @brief Captures a message by interned key id.
+     * @param key Id from Localizer::internKey().
+     * @param args Typed arguments, copied.
      */
-    [[nodiscard]] static DebugOptions &getDebugOptions()
+    DeferredMessage(Localizer::KeyId key, std::initializer_list<Arg> args = {}) : key(key)
     {
-        LOC_WRITE_LOCK
-        return debugOptions;
+        capture(args);
     }
 
     /**
-     * @brief Retrieves const reference to current debug options.
-     * @return Const reference to DebugOptions.
+     * @brief Captures a message by key text (interned on construction).
+     * @param key Translation key.
+     * @param args Typed arguments, copied.
      */
-    [[nodiscard]] static const DebugOptions &getDebugOptionsConst() noexcept
+    DeferredMessage(std::string_view key, std::initializer_list<Arg> args = {})
+        : DeferredMessage(Localizer::internKey(key), args)
     {
-        LOC_READ_LOCK
-        return debugOptions;
     }
 
+    DeferredMessage(const DeferredMessage &) = default;
+    DeferredMessage &operator=(const DeferredMessage &) = default;
+
+    [[nodiscard]] Localizer::KeyId keyId() const noexcept { return key; }
+    [[nodiscard]] std::size_t argCount() const noexcept { return count; }
+
     /**
-     * @brief Prints summary statistics of loaded languages.
+     * @brief Renders in every loaded locale, or in a chosen subset.
+     *
+     * @details
+     * Numeric arguments are formatted once and shared by all locales.
+     *
+     * @param locales Locales to render; empty for all loaded locales.
+     * @return All results in one contiguous buffer with an offset table.
      */
-    static void printStats()
+    [[nodiscard]] LocaleRenderSet renderAllLocales(const std::vector<std::string_view> &locales = {}) const
     {
-        LOC_READ_LOCK
-        std::cout << "📦 LocalizeController loaded " << translations.size() << " languages:\n";
-        for (const auto &[lang, map] : translations)
-            std::cout << "  🌐 " << lang << " -> " << map.size() << " keys\n";
+        std::string formatted;
+        std::pair<std::uint32_t, std::uint32_t> spans[LOC_DEFERRED_MAX_ARGS];
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            spans[i].first = static_cast<std::uint32_t>(formatted.size());
+            emit(slots[i], [&formatted](std::string_view part) { formatted.append(part); });
+            spans[i].second = static_cast<std::uint32_t>(formatted.size() - spans[i].first);
+        }
+
+        return LocalizedString::renderLocales(
+            Localizer::keyName(key), &locales,
+            [&](std::string_view name, auto &&sink)
+            {
+                for (std::uint8_t i = 0; i < count; ++i)
+                {
+                    if (std::string_view(textBase() + slots[i].nameOffset, slots[i].nameLength) == name)
+                    {
+                        sink(std::string_view(formatted).substr(spans[i].first, spans[i].second));
+                        return true;
+                    }
+                }
+                return false;
+            });
+    }
+
+    /**
+     * @brief Serializes the message into a compact binary form for IPC.
+     *
+     * @details
+     * The message carries a 64-bit key hash instead of the key text, typed
+     * argument values, and argument names as small indices into the key's
+     * placeholder list. The receiver renders it in its own locale with
+     * deserialize(); the sender's catalog fingerprint is included so
+     * mismatched catalogs are detected.
+     *
+     * @return Binary message.
+     */
+    [[nodiscard]] std::string serialize() const
+    {
+        std::vector<Arg> args;
+        args.reserve(count);
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            Arg arg(std::string_view(textBase() + slots[i].nameOffset, slots[i].nameLength), std::uint64_t(0));
+            arg.type = slots[i].type;
+            arg.setBits(slots[i].bits);
+            if (arg.type == ArgType::String)
+                arg.text = std::string_view(textBase() + slots[i].textOffset, slots[i].textLength);
+            args.push_back(arg);
+        }
+        return encode(Localizer::keyName(key), args);
+    }
+
+    /**
+     * @brief Reconstructs a message produced by serialize().
+     * @param bytes Binary message.
+     * @param catalogMatches Optional; receives whether the sender's catalog fingerprint matches ours.
+     *        If null, a mismatch is reported through the error callback.
+     * @return Message, or std::nullopt if it cannot be decoded against the current catalog.
+     */
+    [[nodiscard]] static std::optional<DeferredMessage> deserialize(std::string_view bytes, bool *catalogMatches = nullptr)
+    {
+        std::optional<DeferredMessage> result;
+        std::vector<Arg> args;
+        Localizer::KeyId id = 0;
+        bool ok = decode(bytes, catalogMatches,
+                         [&id](std::string_view key) { id = Localizer::internKey(key); },
+                         [&args](const Arg &arg) { args.push_back(arg); });
+        if (ok)
+        {
+            result.emplace(id);
+            result->capture(args);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Renders in the current locale.
+     * @return Localized, formatted text.
+     */
+    [[nodiscard]] std::string render() const
+    {
+        return format(Localizer::translateHandle(Localizer::keyName(key)));
+    }
+
+    /**
+     * @brief Renders in an explicit locale (falling back to the default locale).
+     * @param locale Language code.
+     * @return Localized, formatted text.
+     */
+    [[nodiscard]] std::string render(std::string_view locale) const
+    {
+        return format(Localizer::translateHandleIn(locale, Localizer::keyName(key)));
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const DeferredMessage &m)
+    {
+        return os << m.render();
     }
 };
 
+inline std::string LocalizedString::serialize() const
+{
+    std::vector<DeferredMessage::Arg> args;
+    args.reserve(params.size());
+    for (const auto &[name, value] : params)
+        args.emplace_back(name, value);
+    return DeferredMessage::encode(key, args);
+}
+
+inline std::optional<LocalizedString> LocalizedString::deserialize(std::string_view bytes, bool *catalogMatches)
+{
+    std::string key;
+    std::unordered_map<std::string, std::string> params;
+    bool ok = DeferredMessage::decode(bytes, catalogMatches,
+                                      [&key](std::string_view k) { key.assign(k); },
+                                      [&params](const DeferredMessage::Arg &arg)
+                                      {
+                                          std::string &value = params[std::string(arg.name)];
+                                          DeferredMessage::emitArg(arg, [&value](std::string_view part) { value.append(part); });
+                                      });
+    if (!ok)
+        return std::nullopt;
+    return LocalizedString(std::move(key), std::move(params));
+}
+
 // ============================================================================
-// LocalizedString
+// DocumentTemplate
 // ============================================================================
 
 /**
- * @class LocalizedString
- * @brief Represents a localized string with optional placeholder substitution.
+ * @class DocumentTemplate
+ * @brief Compiled form of a document containing `{{t:key}}` markers.
+ *
+ * @details
+ * compile() scans the document once and records literal spans and marker
+ * keys (deduplicated, with their hashes). A compiled template can be cached
+ * and re-rendered any number of times: render() only resolves the distinct
+ * keys against one pinned catalog and emits scatter-gather segments that
+ * reference the template's own text and catalog memory, without copying.
  */
-class LocalizedString
+class DocumentTemplate
 {
 private:
-    std::string key;                                     ///< Localization key.
-    std::unordered_map<std::string, std::string> params; ///< Placeholder substitutions.
+    static constexpr std::uint32_t LITERAL = std::numeric_limits<std::uint32_t>::max();
+
+    /// Literal span of `source`, or a marker referring to `keys[key]`.
+    struct Part
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint32_t key;
+    };
+
+    /// Distinct marker key, stored as a span of `source`.
+    struct Key
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint64_t hash;
+    };
+
+    std::string source;      ///< Copy of the document.
+    std::vector<Part> parts; ///< Document order.
+    std::vector<Key> keys;   ///< Distinct keys.
+
+    [[nodiscard]] std::string_view keyText(const Key &k) const noexcept
+    {
+        return std::string_view(source).substr(k.offset, k.length);
+    }
+
+    static LocIoVec segment(const char *data, std::size_t length) noexcept
+    {
+        LocIoVec v;
+        v.iov_base = const_cast<char *>(data);
+        v.iov_len = length;
+        return v;
+    }
+
+public:
+    DocumentTemplate() = default;
 
     /**
-     * @brief Applies placeholder substitutions on the text.
-     * @param text Original text with placeholders.
-     * @param params Map of placeholder → value pairs.
-     * @return Text with replaced placeholders.
+     * @brief Compiles a document.
+     * @param document Document text; copied.
+     */
+    explicit DocumentTemplate(std::string_view document) { compile(document); }
+
+    /**
+     * @brief Compiles a document, replacing the previous contents.
+     *
+     * @details
+     * Candidate markers are located with `memchr`, which the C library
+     * vectorizes, so long marker-free stretches are skipped at memory
+     * bandwidth. A `{{t:` without a closing `}}` is kept as literal text.
+     *
+     * @param document Document text; copied.
      */
-    static std::string applyPlaceholders(const std::string &text,
-                                         const std::unordered_map<std::string, std::string> &params)
+    void compile(std::string_view document)
     {
-#if LOC_USE_REGEX
-        std::string result = text;
-        for (const auto &[name, value] : params)
-        {
-            std::regex pattern("\\{" + name + "\\}");
-            result = std::regex_replace(result, pattern, value);
-        }
-        return result;
-#else
-        std::string result;
-        result.reserve(text.size() + 32);
+        source.assign(document);
+        parts.clear();
+        keys.clear();
 
+        constexpr std::string_view open = "{{t:";
+        std::unordered_map<std::string_view, std::uint32_t> index;
+        const char *base = source.data();
+        std::size_t literalStart = 0;
         std::size_t pos = 0;
-        while (pos < text.size())
+
+        auto literal = [&](std::size_t end)
         {
-            auto open = text.find('{', pos);
-            if (open == std::string::npos)
-            {
-                result.append(text, pos, text.size() - pos);
-                break;
-            }
+            if (end > literalStart)
+                parts.push_back({static_cast<std::uint32_t>(literalStart), static_cast<std::uint32_t>(end - literalStart), LITERAL});
+        };
 
-            result.append(text, pos, open - pos);
+        while (pos < source.size())
+        {
+            const void *hit = std::memchr(base + pos, '{', source.size() - pos);
+            if (!hit)
+                break;
+            pos = static_cast<std::size_t>(static_cast<const char *>(hit) - base);
 
-            auto close = text.find('}', open + 1);
-            if (close == std::string::npos)
+            std::string_view rest = std::string_view(source).substr(pos);
+            if (rest.substr(0, open.size()) != open)
             {
-                result.append(text, open, text.size() - open);
-                break;
+                ++pos;
+                continue;
             }
+            std::size_t close = rest.find("}}", open.size());
+            if (close == std::string_view::npos)
+                break;
 
-            std::string key = text.substr(open + 1, close - open - 1);
-            if (auto it = params.find(key); it != params.end())
-                result += it->second;
-            else
-                result.append(text, open, close - open + 1);
+            std::string_view key = rest.substr(open.size(), close - open.size());
+            auto [it, inserted] = index.emplace(key, static_cast<std::uint32_t>(keys.size()));
+            if (inserted)
+                keys.push_back({static_cast<std::uint32_t>(pos + open.size()), static_cast<std::uint32_t>(key.size()), Localizer::hashKey(key)});
 
-            pos = close + 1;
+            literal(pos);
+            parts.push_back({static_cast<std::uint32_t>(pos), static_cast<std::uint32_t>(close + 2), it->second});
+            pos += close + 2;
+            literalStart = pos;
         }
-        return result;
-#endif
+        literal(source.size());
     }
 
-public:
-    /**
-     * @brief Constructs a localized string without parameters.
-     * @param key Translation key.
-     */
-    explicit LocalizedString(std::string key) : key(std::move(key)) {}
+    [[nodiscard]] std::size_t markerCount() const noexcept
+    {
+        std::size_t n = 0;
+        for (const Part &part : parts)
+            n += part.key != LITERAL;
+        return n;
+    }
 
-    /**
-     * @brief Constructs a localized string with parameters.
-     * @param key Translation key.
-     * @param params Map of placeholder values.
-     */
-    LocalizedString(std::string key, std::unordered_map<std::string, std::string> params)
-        : key(std::move(key)), params(std::move(params)) {}
+    [[nodiscard]] std::size_t keyCount() const noexcept { return keys.size(); }
 
     /**
-     * @brief Retrieves the resolved localized string.
-     * @return Localized text with substituted parameters.
+     * @brief Renders into scatter-gather segments.
+     *
+     * @details
+     * Segments point into this template and into the pinned catalog; they
+     * stay valid while both live and the template is not recompiled.
+     * Unknown keys render as `[Missing:key]`. Segments are appended to `out`;
+     * callers passing them to `writev` must respect `IOV_MAX`.
+     *
+     * @param pin Catalog generation to resolve against.
+     * @param locale Language code (falls back to the default locale).
+     * @param out Receives the segments.
      */
-    [[nodiscard]] std::string str() const
+    void render(const CatalogPin &pin, std::string_view locale, std::vector<LocIoVec> &out) const
     {
-        std::string base = Localizer::translate(key);
-        return params.empty() ? base : applyPlaceholders(base, params);
+        static constexpr std::string_view missingOpen = "[Missing:";
+        static constexpr std::string_view missingClose = "]";
+
+        std::vector<std::optional<std::string_view>> values;
+        values.reserve(keys.size());
+        for (const Key &k : keys)
+            values.push_back(pin.find(locale, keyText(k), k.hash));
+
+        out.reserve(out.size() + parts.size());
+        for (const Part &part : parts)
+        {
+            if (part.key == LITERAL)
+            {
+                out.push_back(segment(source.data() + part.offset, part.length));
+            }
+            else if (const auto &value = values[part.key])
+            {
+                if (!value->empty())
+                    out.push_back(segment(value->data(), value->size()));
+            }
+            else
+            {
+                std::string_view key = keyText(keys[part.key]);
+                out.push_back(segment(missingOpen.data(), missingOpen.size()));
+                out.push_back(segment(key.data(), key.size()));
+                out.push_back(segment(missingClose.data(), missingClose.size()));
+            }
+        }
     }
 
     /**
-     * @brief Implicit conversion to std::string.
+     * @brief Renders into one string.
+     * @param pin Catalog generation to resolve against.
+     * @param locale Language code (falls back to the default locale).
+     * @return Localized document.
      */
-    [[nodiscard]] operator std::string() const { return str(); }
+    [[nodiscard]] std::string renderToString(const CatalogPin &pin, std::string_view locale) const
+    {
+        std::vector<LocIoVec> segments;
+        render(pin, locale, segments);
+        std::size_t total = 0;
+        for (const LocIoVec &v : segments)
+            total += v.iov_len;
+        std::string result;
+        result.reserve(total);
+        for (const LocIoVec &v : segments)
+            result.append(static_cast<const char *>(v.iov_base), v.iov_len);
+        return result;
+    }
 
     /**
-     * @brief Stream output operator.
-     * @param os Output stream.
-     * @param s LocalizedString instance.
-     * @return Reference to output stream.
+     * @brief Renders into one string in the current locale against the current catalog.
+     * @return Localized document.
      */
-    friend std::ostream &operator<<(std::ostream &os, const LocalizedString &s)
+    [[nodiscard]] std::string renderToString() const
     {
-        return os << s.str();
+        CatalogPin pinned = Localizer::pin();
+        return renderToString(pinned, Localizer::localeName(pinned.localeId()));
     }
 };
 
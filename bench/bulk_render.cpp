@@ -0,0 +1,96 @@
+/**
+ * @file bulk_render.cpp
+ * @brief renderBulk() throughput against per-record setLocale() + str().
+ *
+ * Renders N records spread over 4 locales × 3 keys with 1000 distinct
+ * parameter maps, first with the baseline loop (setLocale() then
+ * LocalizedString::str() per record, as a mail-merge job would), then with
+ * LocalizedString::renderBulk() on 1 and on all hardware threads. Fails if
+ * any bulk output differs from the baseline.
+ *
+ * Usage: bulk_render [records] [workers]
+ */
+#include <Localizer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    using clock = std::chrono::steady_clock;
+
+    const long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const unsigned workers = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+
+    auto dir = std::filesystem::temp_directory_path() / "localizer-bench";
+    std::filesystem::create_directories(dir);
+    auto path = dir / "mail.json";
+    {
+        std::ofstream out(path);
+        out << R"({
+  "en": { "greeting": "Hello, {name}!", "order": "Order {id} ships on {date}.", "footer": "Thanks, {name}." },
+  "fr": { "greeting": "Bonjour, {name} !", "order": "La commande {id} part le {date}.", "footer": "Merci, {name}." },
+  "de": { "greeting": "Hallo, {name}!", "order": "Bestellung {id} wird am {date} versandt.", "footer": "Danke, {name}." },
+  "es": { "greeting": "¡Hola, {name}!", "order": "El pedido {id} sale el {date}.", "footer": "Gracias, {name}." }
+})";
+    }
+    Localizer::loadFromFile(path.string());
+
+    const char *locales[] = {"en", "fr", "de", "es"};
+    const char *keys[] = {"mail.greeting", "mail.order", "mail.footer"};
+
+    std::vector<std::unordered_map<std::string, std::string>> params(1000);
+    for (std::size_t i = 0; i < params.size(); ++i)
+        params[i] = {{"name", "Customer " + std::to_string(i)},
+                     {"id", std::to_string(100000 + i)},
+                     {"date", "2024-05-" + std::to_string(1 + i % 28)}};
+
+    std::vector<LocalizedString::BulkRecord> records(static_cast<std::size_t>(count));
+    for (long i = 0; i < count; ++i)
+        records[i] = {locales[(i / 3) % 4], keys[i % 3], &params[static_cast<std::size_t>(i) % params.size()]};
+
+    std::vector<std::string> expected(records.size());
+    auto start = clock::now();
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        (void)Localizer::setLocale(std::string(records[i].locale));
+        expected[i] = LocalizedString(std::string(records[i].key), *records[i].params).str();
+    }
+    double baseline = std::chrono::duration<double>(clock::now() - start).count();
+    std::printf("%ld records, baseline setLocale + str(): %.0f ms (%.0f ns/record)\n", count, baseline * 1000,
+                baseline * 1e9 / count);
+
+    std::atomic<long> mismatches{0};
+    long long checksum = 0;
+    for (unsigned threads : {1u, workers})
+    {
+        std::atomic<long long> bytes{0};
+        start = clock::now();
+        LocalizedString::renderBulk(
+            records,
+            [&](std::size_t index, std::string_view text)
+            {
+                bytes.fetch_add(static_cast<long long>(text.size()), std::memory_order_relaxed);
+                if (text != expected[index])
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+            },
+            threads);
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        std::printf("renderBulk, %u worker(s): %.0f ms (%.0f ns/record, %.1fx baseline)\n", threads, seconds * 1000,
+                    seconds * 1e9 / count, baseline / seconds);
+        checksum += bytes;
+    }
+
+    std::filesystem::remove(path);
+    if (mismatches)
+        std::fprintf(stderr, "%ld records differ from the baseline\n", mismatches.load());
+    return mismatches || checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file catalog_memory.cpp
+ * @brief Catalog footprint at 1M entries, for the hash and compact layouts.
+ *
+ * Generates one namespace with N entries, loads it through a counting
+ * memory resource and reports catalog arena bytes, per-entry overhead over
+ * the raw key/value text and the RSS growth. Build once per layout
+ * (`catalog_memory` and `catalog_memory_compact`).
+ *
+ * Usage: catalog_memory [entries]
+ */
+#include <Localizer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/// Forwards to new/delete and tracks the bytes currently allocated.
+struct CountingResource : std::pmr::memory_resource
+{
+    std::atomic<long long> live{0};
+
+    void *do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        live += static_cast<long long>(bytes);
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t align) override
+    {
+        live -= static_cast<long long>(bytes);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+/// Resident set size in bytes, 0 where /proc is unavailable.
+static long long residentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    long long pages = 0, resident = 0;
+    if (!(statm >> pages >> resident))
+        return 0;
+    return resident * 4096;
+}
+
+static std::string keyOf(long i) { return "group" + std::to_string(i / 1000) + ".key" + std::to_string(i); }
+static std::string valueOf(long i) { return "Value number " + std::to_string(i); }
+
+int main(int argc, char **argv)
+{
+    const long entries = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    auto dir = std::filesystem::temp_directory_path() / "localizer-bench";
+    std::filesystem::create_directories(dir);
+    auto path = dir / "big.json";
+    long long text = 0;
+    {
+        std::ofstream out(path);
+        out << "{\"en\":{";
+        for (long g = 0; g * 1000 < entries; ++g)
+        {
+            out << (g ? "," : "") << "\"group" << g << "\":{";
+            for (long i = g * 1000; i < std::min(entries, (g + 1) * 1000); ++i)
+            {
+                out << (i % 1000 ? "," : "") << "\"key" << i << "\":\"" << valueOf(i) << '"';
+                text += static_cast<long long>(("big." + keyOf(i)).size() + valueOf(i).size());
+            }
+            out << '}';
+        }
+        out << "}}";
+    }
+
+    static CountingResource counting;
+    Localizer::setMemoryResource(&counting);
+    long long before = residentBytes();
+    auto start = std::chrono::steady_clock::now();
+    Localizer::loadFromFile(path.string());
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#if defined(__GLIBC__)
+    malloc_trim(0); // return the parser's temporaries before measuring
+#endif
+    long long after = residentBytes();
+
+    std::printf("layout: %s, %ld entries, load %.0f ms\n", LOC_COMPACT_CATALOG ? "compact" : "hash", entries,
+                loadSeconds * 1000);
+    std::printf("catalog arena: %.1f MB (key/value text %.1f MB, overhead %.1f B/entry)\n", counting.live / 1e6,
+                text / 1e6, double(counting.live.load() - text) / entries);
+    std::printf("RSS growth: %.1f MB\n", (after - before) / 1e6);
+
+    long hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < entries; ++i)
+        hits += Localizer::hasKey("big." + keyOf(i));
+    std::printf("%ld/%ld hasKey hits in %.2f s\n", hits, entries,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    std::filesystem::remove(path);
+    return hits == entries ? 0 : 1;
+}
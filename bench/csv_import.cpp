@@ -0,0 +1,133 @@
+/**
+ * @file csv_import.cpp
+ * @brief Spreadsheet imports against the equivalent JSON catalog.
+ *
+ * Generates rows whose cells hold delimiters, `""` escapes, line breaks
+ * (LF and CRLF) inside quotes, UTF-8 text and empty cells, and writes them
+ * as a CSV with a BOM and mixed line endings, as a TSV, and as the JSON
+ * file a converter would produce. The target is built with a 7-byte
+ * `LOC_CSV_CHUNK_SIZE`, so quotes, escapes and line breaks land on every
+ * chunk boundary. Fails unless translate() returns the same text for every
+ * key and locale of the three files.
+ *
+ * Usage: csv_import [rows]
+ */
+#include <Localizer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char *locales[] = {"en", "fr", "de"};
+
+    /// Cell content for a row and column; columns cycle through the tricky cases.
+    std::string cellOf(long row, int column)
+    {
+        std::string n = std::to_string(row);
+        switch ((row + column) % 9)
+        {
+        case 0:
+            return "Plain " + n;
+        case 1:
+            return "Comma, then tab\tand more " + n;
+        case 2:
+            return "Say \"" + n + "\" twice \"\"";
+        case 3:
+            return "Line one " + n + "\nline two";
+        case 4:
+            return "CRLF " + n + "\r\ninside";
+        case 5:
+            return column == 1 ? "Fallback source " + n : ""; // empty cells fall back to `en`
+        case 6:
+            return "Ünïcødé ✓ " + n;
+        case 7:
+            return "\"";
+        default:
+            return "  padded " + n + "  ";
+        }
+    }
+
+    /// Quotes a cell when it needs it (and every third plain one, to cover both paths).
+    std::string quoted(const std::string &cell, char delimiter, long row)
+    {
+        bool needs = cell.find_first_of(std::string("\"\r\n") + delimiter) != std::string::npos;
+        if (!needs && row % 3)
+            return cell;
+        std::string out = "\"";
+        for (char c : cell)
+            out += c == '"' ? std::string("\"\"") : std::string(1, c);
+        return out + '"';
+    }
+
+    void writeSheet(const std::filesystem::path &path, char delimiter, long rows)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (delimiter == ',')
+            out << "\xEF\xBB\xBF";
+        out << "key" << delimiter << "en" << delimiter << "fr" << delimiter << "de\n";
+        for (long row = 0; row < rows; ++row)
+        {
+            out << "row" << row;
+            for (int column = 1; column <= 3; ++column)
+                out << delimiter << quoted(cellOf(row, column), delimiter, row);
+            if (row + 1 < rows) // the last record has no line break
+                out << (row % 2 ? "\r\n" : "\n");
+        }
+    }
+
+    void writeJson(const std::filesystem::path &path, long rows)
+    {
+        nlohmann::json root;
+        for (int column = 1; column <= 3; ++column)
+        {
+            nlohmann::json &locale = root[locales[column - 1]] = nlohmann::json::object();
+            for (long row = 0; row < rows; ++row)
+                if (std::string cell = cellOf(row, column); !cell.empty())
+                    locale["row" + std::to_string(row)] = cell;
+        }
+        std::ofstream(path, std::ios::binary) << root.dump();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const long rows = argc > 1 ? std::atol(argv[1]) : 2000;
+
+    auto dir = std::filesystem::temp_directory_path() / "localizer-csv-import";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    writeSheet(dir / "sheet.csv", ',', rows);
+    writeSheet(dir / "tabbed.tsv", '\t', rows);
+    writeJson(dir / "table.json", rows);
+
+    Localizer::loadFromFile((dir / "table.json").string());
+    Localizer::loadFromFile((dir / "sheet.csv").string());
+    Localizer::loadFromFile((dir / "tabbed.tsv").string());
+
+    long failures = 0;
+    for (const char *locale : locales)
+    {
+        (void)Localizer::setLocale(locale);
+        for (long row = 0; row < rows; ++row)
+        {
+            std::string key = "row" + std::to_string(row);
+            std::string want = Localizer::translate("table." + key);
+            for (const char *ns : {"sheet", "tabbed"})
+            {
+                std::string got = Localizer::translate(ns + std::string(".") + key);
+                if (got != want && failures++ < 10)
+                    std::printf("FAIL %s %s.%s\n  got:  %s\n  want: %s\n", locale, ns, key.c_str(), got.c_str(),
+                                want.c_str());
+            }
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+    std::printf("%ld rows x %zu locales, CSV and TSV, %ld mismatches\n", rows, std::size(locales), failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file mo_vs_json.cpp
+ * @brief Load time, RSS and lookup latency of a mapped .mo catalog against the same entries in JSON.
+ *
+ * Generates N entries as a gettext `.mo` file (with or without the hash
+ * table) or as JSON, loads one of them and times random translateRealtime()
+ * lookups. Each run measures one source so the RSS figures do not mix; the
+ * JSON numbers depend on the layout, so `mo_vs_json_compact` is the same
+ * program built with LOC_COMPACT_CATALOG. Fails if any lookup misses.
+ *
+ * Usage: mo_vs_json [entries] [mo|mo-nohash|json] [lookups]
+ */
+#include <Localizer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/// Resident set size in bytes, 0 where /proc is unavailable.
+static long long residentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    long long pages = 0, resident = 0;
+    if (!(statm >> pages >> resident))
+        return 0;
+    return resident * 4096;
+}
+
+static std::string msgidOf(long i) { return "msg" + std::to_string(i); }
+static std::string valueOf(long i) { return "Translated message number " + std::to_string(i); }
+
+/// gettext's hashpjw, as used for the .mo hash table.
+static std::uint32_t hashpjw(const std::string &text)
+{
+    std::uint32_t hash = 0;
+    for (char c : text)
+    {
+        hash = (hash << 4) + static_cast<unsigned char>(c);
+        std::uint32_t g = hash & 0xf0000000u;
+        if (g)
+            hash ^= (g >> 24) ^ g;
+    }
+    return hash;
+}
+
+static std::uint32_t nextPrime(std::uint32_t n)
+{
+    auto prime = [](std::uint32_t v)
+    {
+        for (std::uint32_t d = 2; d * d <= v; ++d)
+            if (v % d == 0)
+                return false;
+        return v > 1;
+    };
+    while (!prime(n))
+        ++n;
+    return n;
+}
+
+/// Writes a little-endian .mo file: header entry plus `entries` sorted msgids.
+static void writeMo(const std::filesystem::path &path, long entries, bool withHash)
+{
+    std::vector<std::pair<std::string, std::string>> strings;
+    strings.reserve(static_cast<std::size_t>(entries) + 1);
+    strings.emplace_back("", "Content-Type: text/plain; charset=UTF-8\nLanguage: en\n");
+    for (long i = 0; i < entries; ++i)
+        strings.emplace_back(msgidOf(i), valueOf(i));
+    std::sort(strings.begin(), strings.end());
+
+    const auto count = static_cast<std::uint32_t>(strings.size());
+    const std::uint32_t hashSize = withHash ? nextPrime(count * 4 / 3 + 3) : 0;
+    const std::uint32_t originals = 28;
+    const std::uint32_t translations = originals + 8 * count;
+    const std::uint32_t hashOffset = translations + 8 * count;
+    std::uint32_t text = hashOffset + 4 * hashSize;
+
+    std::vector<std::uint32_t> words = {0x950412deu, 0, count, originals, translations, hashSize, hashOffset};
+    std::string blob;
+    for (int table = 0; table < 2; ++table)
+    {
+        for (const auto &entry : strings)
+        {
+            const std::string &s = table == 0 ? entry.first : entry.second;
+            words.push_back(static_cast<std::uint32_t>(s.size()));
+            words.push_back(text + static_cast<std::uint32_t>(blob.size()));
+            blob.append(s).push_back('\0');
+        }
+    }
+
+    std::vector<std::uint32_t> hashTable(hashSize, 0);
+    for (std::uint32_t i = 0; i < count && hashSize; ++i)
+    {
+        std::uint32_t hash = hashpjw(strings[i].first);
+        std::uint32_t index = hash % hashSize;
+        std::uint32_t step = 1 + hash % (hashSize - 2);
+        while (hashTable[index])
+            index = index >= hashSize - step ? index - (hashSize - step) : index + step;
+        hashTable[index] = i + 1;
+    }
+    words.insert(words.end(), hashTable.begin(), hashTable.end());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(words.data()), static_cast<std::streamsize>(words.size() * 4));
+    out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+}
+
+static void writeJson(const std::filesystem::path &path, long entries)
+{
+    std::ofstream out(path);
+    out << "{\"en\":{";
+    for (long i = 0; i < entries; ++i)
+        out << (i ? "," : "") << '"' << msgidOf(i) << "\":\"" << valueOf(i) << '"';
+    out << "}}";
+}
+
+int main(int argc, char **argv)
+{
+    using clock = std::chrono::steady_clock;
+
+    const long entries = argc > 1 ? std::atol(argv[1]) : 200000;
+    const std::string mode = argc > 2 ? argv[2] : "mo";
+    const long lookups = argc > 3 ? std::atol(argv[3]) : 2000000;
+    if (mode != "mo" && mode != "mo-nohash" && mode != "json")
+    {
+        std::fprintf(stderr, "unknown source '%s' (mo, mo-nohash or json)\n", mode.c_str());
+        return 2;
+    }
+
+    auto dir = std::filesystem::temp_directory_path() / "localizer-bench";
+    std::filesystem::create_directories(dir);
+    auto path = dir / (mode == "json" ? "bench.json" : "bench.mo");
+    if (mode == "json")
+        writeJson(path, entries);
+    else
+        writeMo(path, entries, mode == "mo");
+
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    long long before = residentBytes();
+    auto start = clock::now();
+    Localizer::loadFromFile(path.string());
+    double loadSeconds = std::chrono::duration<double>(clock::now() - start).count();
+#if defined(__GLIBC__)
+    malloc_trim(0); // return the parser's temporaries before measuring
+#endif
+    long long after = residentBytes();
+
+    std::vector<std::string> keys;
+    keys.reserve(4096);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<long> pick(0, entries - 1);
+    for (int i = 0; i < 4096; ++i)
+        keys.push_back("bench." + msgidOf(pick(rng)));
+
+    char buffer[128];
+    long misses = 0;
+    start = clock::now();
+    for (long i = 0; i < lookups; ++i)
+        misses += !Localizer::translateRealtime(keys[static_cast<std::size_t>(i) & 4095], buffer, sizeof(buffer)).found;
+    double lookupSeconds = std::chrono::duration<double>(clock::now() - start).count();
+    long long touched = residentBytes();
+
+    const char *source = mode == "json" ? (LOC_COMPACT_CATALOG ? "json (compact)" : "json (hash)")
+                                        : (mode == "mo" ? ".mo (hash table)" : ".mo (binary search)");
+    std::printf("%s, %ld entries: load %.1f ms, RSS growth %.1f MB after load, %.1f MB after lookups\n", source,
+                entries, loadSeconds * 1000, (after - before) / 1e6, (touched - before) / 1e6);
+    std::printf("%ld random translateRealtime() lookups: %.0f ns each, %ld misses\n", lookups,
+                lookupSeconds * 1e9 / lookups, misses);
+
+    std::filesystem::remove(path);
+    return misses ? 1 : 0;
+}
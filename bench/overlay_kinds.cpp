@@ -0,0 +1,139 @@
+/**
+ * @file overlay_kinds.cpp
+ * @brief Overlays replacing strings, typed leaves and variant sets with one another.
+ *
+ * For every base kind × overlay kind (string, typed, variants), in the
+ * default locale and in another one, a key is loaded from a base file and
+ * patched by an overlay file. The overlay must win completely: translate(),
+ * getInt(), variantCount() and translateVariant() see only the overlay's
+ * value. The base files are then rewritten to the expected merged content
+ * and reloaded without overlays; the observations and the catalog
+ * fingerprint must not change.
+ *
+ * Usage: overlay_kinds
+ */
+#include <Localizer.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char *kinds[] = {"string", "typed", "variants"};
+
+    /// JSON value of a leaf of the given kind; `overlay` picks distinct content.
+    std::string leaf(int kind, bool overlay)
+    {
+        switch (kind)
+        {
+        case 0:
+            return overlay ? "\"Overlay\"" : "\"Base\"";
+        case 1:
+            return overlay ? "7" : "5";
+        default:
+            return overlay ? R"({"_variants": ["X", "Y"]})" : R"({"_variants": ["A", "B", "C"]})";
+        }
+    }
+
+    struct Case
+    {
+        int base, overlay;
+        std::string locale, stem;
+    };
+
+    void writeFile(const std::filesystem::path &path, const std::string &locale, const std::string &value)
+    {
+        std::ofstream(path) << "{\"" << locale << "\": {\"k\": " << value << "}}";
+    }
+
+    /// What the public API reports for the key of a case.
+    std::string observe(const Case &c)
+    {
+        (void)Localizer::setLocale(c.locale);
+        std::string key = c.stem + ".k";
+        std::optional<std::int64_t> number = Localizer::getInt(key);
+        return Localizer::translate(key) + " | int " + (number ? std::to_string(*number) : "-") + " | variants " +
+               std::to_string(Localizer::variantCount(key)) + " | #1 " + Localizer::translateVariant(key, 1);
+    }
+
+    /// Expected observation: only the overlay's value is visible.
+    std::string expected(const Case &c)
+    {
+        std::string missing = "[Missing:" + c.stem + ".k]";
+        switch (c.overlay)
+        {
+        case 0:
+            return "Overlay | int - | variants 0 | #1 Overlay";
+        case 1:
+            return missing + " | int 7 | variants 0 | #1 " + missing;
+        default:
+            return "X | int - | variants 2 | #1 Y";
+        }
+    }
+}
+
+int main()
+{
+    auto dir = std::filesystem::temp_directory_path() / "localizer-overlay-kinds";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "base");
+    std::filesystem::create_directories(dir / "ov");
+
+    // The default locale has to exist in both runs for the fingerprint to mean anything.
+    std::ofstream(dir / "base" / "anchor.json") << "{\"" << LOC_DEFAULT_LOCALE << "\": {\"k\": \"anchor\"}}";
+
+    std::vector<Case> cases;
+    for (const char *locale : {LOC_DEFAULT_LOCALE, "fr"})
+        for (int base = 0; base < 3; ++base)
+            for (int overlay = 0; overlay < 3; ++overlay)
+            {
+                Case c{base, overlay, locale, "c" + std::to_string(cases.size())};
+                writeFile(dir / "base" / (c.stem + ".json"), c.locale, leaf(base, false));
+                writeFile(dir / "ov" / (c.stem + ".json"), c.locale, leaf(overlay, true));
+                cases.push_back(c);
+            }
+
+    Localizer::loadFromDirectory((dir / "base").string());
+    for (const Case &c : cases)
+        Localizer::addOverlay(c.stem, (dir / "ov" / (c.stem + ".json")).string());
+
+    int failures = 0;
+    auto check = [&failures](const Case &c, const char *phase)
+    {
+        std::string got = observe(c), want = expected(c);
+        if (got != want)
+        {
+            std::printf("FAIL %s %s: base %s, overlay %s\n  got:  %s\n  want: %s\n", phase, c.locale.c_str(),
+                        kinds[c.base], kinds[c.overlay], got.c_str(), want.c_str());
+            ++failures;
+        }
+    };
+    for (const Case &c : cases)
+        check(c, "overlay");
+    std::uint64_t composed = Localizer::catalogFingerprint();
+
+    for (const Case &c : cases)
+    {
+        (void)Localizer::removeOverlay(c.stem);
+        writeFile(dir / "base" / (c.stem + ".json"), c.locale, leaf(c.overlay, true));
+    }
+    Localizer::reloadAllJsons(true);
+    for (const Case &c : cases)
+        check(c, "merged");
+    std::uint64_t merged = Localizer::catalogFingerprint();
+    if (composed != merged)
+    {
+        std::printf("FAIL fingerprint: %016llx with overlays, %016llx for the merged files\n",
+                    static_cast<unsigned long long>(composed), static_cast<unsigned long long>(merged));
+        ++failures;
+    }
+
+    std::filesystem::remove_all(dir);
+    std::printf("%zu cases, %d failures\n", cases.size() * 2, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file realtime_stress.cpp
+ * @brief Worst-case latency of translateRealtime() under concurrent reloads and locale switches.
+ *
+ * Reader threads call translateRealtime() in a tight loop while a writer
+ * alternates reloadAllJsons() (with and without clearing) and setLocale().
+ * Fails if any lookup misses; latency is reported, not asserted, since it
+ * depends on the scheduler.
+ *
+ * Usage: realtime_stress [lookups per reader] [readers]
+ */
+#include <Localizer.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    using clock = std::chrono::steady_clock;
+
+    const long lookups = argc > 1 ? std::atol(argv[1]) : 2000000;
+    const int readers = argc > 2 ? std::atoi(argv[2]) : 3;
+    const char *key = "ui.menu.exit";
+
+    Localizer::loadFromDirectory(LOC_BENCH_LANGS);
+    char probe[64];
+    if (!Localizer::translateRealtime(key, probe, sizeof(probe)).found)
+    {
+        std::fprintf(stderr, "%s is missing from %s\n", key, LOC_BENCH_LANGS);
+        return 1;
+    }
+
+    std::atomic<bool> stop{false};
+    long reloads = 0;
+    std::thread writer([&]
+                       {
+                           for (; !stop.load(); ++reloads)
+                           {
+                               Localizer::reloadAllJsons(reloads % 2 == 1);
+                               (void)Localizer::setLocale(reloads % 3 ? "fr" : "en");
+                           }
+                       });
+
+    // Latency histogram in powers of two nanoseconds.
+    std::array<std::atomic<long>, 40> histogram{};
+    std::atomic<long> worst{0};
+    std::atomic<long> missed{0};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < readers; ++t)
+    {
+        pool.emplace_back([&]
+                          {
+                              char buffer[16];
+                              long local = 0;
+                              for (long i = 0; i < lookups; ++i)
+                              {
+                                  auto start = clock::now();
+                                  RealtimeResult result = Localizer::translateRealtime(key, buffer, sizeof(buffer));
+                                  long ns = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+                                  local = std::max(local, ns);
+                                  std::size_t bucket = 0;
+                                  while (bucket + 1 < histogram.size() && (1l << (bucket + 1)) <= ns)
+                                      ++bucket;
+                                  histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+                                  if (!result.found)
+                                      missed.fetch_add(1);
+                              }
+                              long seen = worst.load();
+                              while (local > seen && !worst.compare_exchange_weak(seen, local))
+                                  ;
+                          });
+    }
+    for (auto &thread : pool)
+        thread.join();
+    stop = true;
+    writer.join();
+
+    const long total = lookups * readers;
+    auto percentile = [&](double fraction)
+    {
+        long target = static_cast<long>(fraction * total), seen = 0;
+        for (std::size_t b = 0; b < histogram.size(); ++b)
+            if ((seen += histogram[b].load()) >= target)
+                return 1l << (b + 1);
+        return 1l << histogram.size();
+    };
+
+    std::printf("%d readers x %ld lookups, %ld reloads\n", readers, lookups, reloads);
+    std::printf("p50 < %ld ns, p99.9 < %ld ns, p99.999 < %ld ns, worst %ld ns\n",
+                percentile(0.5), percentile(0.999), percentile(0.99999), worst.load());
+    std::printf("missed lookups: %ld\n", missed.load());
+    return missed.load() == 0 ? 0 : 1;
+}